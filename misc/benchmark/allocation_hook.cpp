@@ -0,0 +1,95 @@
+// Replaces the global allocation functions so that the benchmark can tell how much
+// memory a data structure asks for while it is being measured.
+//
+
+#include "counters.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace benchmark {
+    static thread_local AllocationStats stats{};
+
+    AllocationStats &allocation_stats() noexcept {
+        return stats;
+    }
+}
+
+// every block carries its requested size in front, keeping malloc's 16 byte alignment
+constexpr std::size_t header = 16;
+
+// over-aligned blocks get a whole alignment unit in front, so that the size still fits
+static void *counted_allocate(std::size_t size, std::size_t alignment = header) {
+    auto raw = alignment <= header ? std::malloc(size + header)
+                                   : std::aligned_alloc(alignment, (size + 2 * alignment - 1) / alignment * alignment);
+    if (!raw) throw std::bad_alloc();
+    alignment = std::max(alignment, header);
+    *static_cast<std::size_t *>(raw) = size;
+    auto &stats = benchmark::allocation_stats();
+    stats.allocations++;
+    stats.bytes_allocated += size;
+    stats.live_bytes += size;
+    stats.live_usable_bytes += malloc_usable_size(raw) - alignment;
+    stats.peak_live_bytes = std::max(stats.peak_live_bytes, stats.live_bytes);
+    return static_cast<char *>(raw) + alignment;
+}
+
+static void counted_free(void *p, std::size_t alignment = header) noexcept {
+    if (!p) return;
+    alignment = std::max(alignment, header);
+    auto raw = static_cast<char *>(p) - alignment;
+    auto &stats = benchmark::allocation_stats();
+    stats.deallocations++;
+    stats.live_bytes -= *reinterpret_cast<std::size_t *>(raw);
+    stats.live_usable_bytes -= malloc_usable_size(raw) - alignment;
+    std::free(raw);
+}
+
+void *operator new(std::size_t size) { return counted_allocate(size); }
+
+void *operator new[](std::size_t size) { return counted_allocate(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try { return counted_allocate(size); } catch (...) { return nullptr; }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    try { return counted_allocate(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void *p) noexcept { counted_free(p); }
+
+void operator delete[](void *p) noexcept { counted_free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { counted_free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { counted_free(p); }
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    return counted_allocate(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return counted_allocate(size, static_cast<std::size_t>(align));
+}
+
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    try { return counted_allocate(size, static_cast<std::size_t>(align)); } catch (...) { return nullptr; }
+}
+
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    try { return counted_allocate(size, static_cast<std::size_t>(align)); } catch (...) { return nullptr; }
+}
+
+void operator delete(void *p, std::align_val_t align) noexcept { counted_free(p, static_cast<std::size_t>(align)); }
+
+void operator delete[](void *p, std::align_val_t align) noexcept { counted_free(p, static_cast<std::size_t>(align)); }
+
+void operator delete(void *p, std::size_t, std::align_val_t align) noexcept {
+    counted_free(p, static_cast<std::size_t>(align));
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t align) noexcept {
+    counted_free(p, static_cast<std::size_t>(align));
+}
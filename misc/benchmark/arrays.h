@@ -5,6 +5,7 @@
 #ifndef DATA_STRUCTURE_FOR_LOVE_ARRAYS_H
 #define DATA_STRUCTURE_FOR_LOVE_ARRAYS_H
 
+#include "benchmark.h"
 #include <optimized_vector.hpp>
 #include <rootish_stack.hpp>
 
@@ -12,88 +13,61 @@ namespace benchmark {
     using namespace data_structure;
 
     struct SLTVector : public BenchMark {
-        explicit SLTVector() noexcept : BenchMark() {}
+        explicit SLTVector() noexcept : BenchMark("STLVector") {}
 
-        long long run(size_t n) {
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
             std::vector<int> vec, test;
             gen_random_int(vec, n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                test.push_back(i);
+                timed([&] { test.push_back(i); });
             }
             for (int i = 0; i < vec.size(); ++i) {
-                test[i] = rand();
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = "STLVector";
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { test[i] = rand(); });
             }
-            return result;
+            return stop();
         }
     } stl_vector;
 
     struct OptArray : public BenchMark {
-        explicit OptArray() noexcept : BenchMark() {}
+        explicit OptArray() noexcept : BenchMark("OptArray") {}
+
+        size_t operations(size_t n) override { return 2 * n; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::vector<int> vec;
             optimized_vector<int, 10000> test;
             gen_random_int(vec, n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                test.push_back(i);
+                timed([&] { test.push_back(i); });
             }
             for (int i = 0; i < vec.size(); ++i) {
-                test[i] = rand();
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = "OptArray";
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { test[i] = rand(); });
             }
-            return result;
+            return stop();
         }
     } opt_array;
 
     struct Rootish : public BenchMark {
-        explicit Rootish() noexcept : BenchMark() {}
+        explicit Rootish() noexcept : BenchMark("RootishArray") {}
+
+        size_t operations(size_t n) override { return 2 * n; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::vector<int> vec;
             RootishStack<int> test;
             gen_random_int(vec, n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                test.push_back(i);
+                timed([&] { test.push_back(i); });
             }
             for (int i = 0; i < vec.size(); ++i) {
-                test[i] = rand();
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = "RootishArray";
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { test[i] = rand(); });
             }
-            return result;
+            return stop();
         }
     } Rootish;
 
@@ -3,21 +3,32 @@
 //
 
 #include "benchmark.h"
-//#include "bin_trees_1.h"
-//#include "bin_trees_2.h"
-//#include "bin_trees_3.h"
-//#include "bin_trees_4.h"
-//#include "heap_insertion.h"
+#include "runner.h"
+#include "bin_trees_1.h"
+#include "bin_trees_2.h"
+#include "bin_trees_3.h"
+#include "bin_trees_4.h"
+#include "bin_trees_5.h"
+#include "bin_trees_6.h"
+#include "bin_trees_7.h"
+#include "heap_insertion.h"
 #include "heap_pop.h"
-//#include "heap_melding.h"
-//#include "heap_decreasing.h"
-//#include "arrays.h"
-//#include "allocation.h"
-//#include "intset_insertion.h"
-//#include "intset_deletion.h"
-//#include "intset_checking.h"
-//#include "intset_extrema.hpp"
-//#include "intset_iteration.h"
-int main() {
-    benchmark::run_all();
+#include "heap_melding.h"
+#include "heap_decreasing.h"
+#include "heap_workload.h"
+#include "heap_monotone.h"
+#include "heap_double_ended.h"
+#include "heap_fork.h"
+#include "heap_dijkstra.h"
+#include "heap_concurrent.h"
+#include "arrays.h"
+#include "allocation.h"
+#include "intset_insertion.h"
+#include "intset_deletion.h"
+#include "intset_checking.h"
+#include "intset_extrema.hpp"
+#include "intset_iteration.h"
+#include "intset_workload.h"
+int main(int argc, char **argv) {
+    return benchmark::run_all(argc, argv);
 }
\ No newline at end of file
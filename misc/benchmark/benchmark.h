@@ -10,35 +10,114 @@
 #include <fstream>
 #include <iostream>
 #include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <regex>
+#include <string>
+#include <memory>
 #include <static_random_helper.hpp>
+#include "counters.h"
+#include "cycle_clock.h"
+#include "histogram.h"
 
 long long seed = std::chrono::steady_clock::now().time_since_epoch().count();
 namespace benchmark {
     struct BenchMark;
     static std::vector<BenchMark *> benchmarks{};
+    // shared by all benchmarks, null when hardware counters are disabled or unavailable
+    static PerfCounters *perf_counters = nullptr;
+
+    /*
+     * Command line options of the runner.
+     * Sizes outside [min_size, max_size] are skipped, the range is further clipped by the default range
+     * of every benchmark. Each size is run `warmup` times without recording, then `repetitions` times.
+     * With a baseline file, only the benchmarks and sizes recorded in it are run and then compared against it.
+     * In latency mode every operation wrapped in BenchMark::timed is timed on its own.
+     */
+    struct Options {
+        std::regex filter{".*"};
+        size_t min_size = 0;
+        size_t max_size = std::numeric_limits<size_t>::max();
+        size_t step = 1;
+        size_t repetitions = 5;
+        size_t warmup = 1;
+        bool list = false;
+        bool counters = true;
+        bool latency = false;
+        std::string format = "json";
+        std::string output;
+        std::string baseline;
+        double alpha = 0.01;
+        double threshold = 0.05;
+
+        static Options parse(int argc, char **argv);
+
+        static void usage(const char *program);
+    };
+
+    /*
+     * Make the optimizer believe `value` is read, so that a measured loop whose results are otherwise unused
+     * (lookups in std::set, for example) is not removed.
+     */
+    template<class T>
+    inline void do_not_optimize(const T &value) noexcept {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /*
+     * What happened between BenchMark::start() and BenchMark::stop().
+     */
+    struct Sample {
+        long long ns = 0;
+        size_t allocations = 0, bytes_allocated = 0;
+        // the most bytes alive at once during the region, beyond those alive at its start
+        size_t peak_bytes = 0;
+        PerfCounters::Values counters{};
+        // peak resident set size of the process during the run, 0 when the peak could not be reset before it
+        long peak_rss_kb = 0;
+    };
+
+    /*
+     * Per operation latency of one size over all recorded repetitions, in nanoseconds.
+     */
+    struct LatencySummary {
+        uint64_t count = 0;
+        double mean = 0, p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+
+        static LatencySummary of(const LatencyHistogram &histogram);
+    };
+
+    struct Statistics {
+        size_t size = 0, operations = 0;
+        long long min = 0, median = 0, p90 = 0, p99 = 0, max = 0;
+        double mean = 0, stddev = 0;
+        // averaged over the recorded repetitions
+        double allocations = 0, bytes_allocated = 0;
+        // the largest over the recorded repetitions
+        size_t peak_bytes = 0;
+        std::array<double, PerfCounters::EVENT_COUNT> counters{};
+        // the largest over the recorded repetitions, 0 when unavailable
+        long peak_rss_kb = 0;
+        std::vector<long long> samples;
+        LatencySummary latency; // count is 0 unless running in latency mode
+
+        static Statistics of(size_t size, size_t operations, const std::vector<Sample> &samples);
+
+        double ns_per_op() const { return operations ? static_cast<double>(median) / operations : 0; }
+
+        double ops_per_sec() const { return median ? operations * 1e9 / median : 0; }
+    };
 
     struct BenchMark {
 
         data_structure::utils::RandomIntGen<size_t> rand{};
+        std::string name;
+        size_t first, last;
 
         struct Result {
             std::string name;
-            using outcome = std::pair<size_t, long long>;
-            std::vector<outcome> outcomes;
-
-            auto output() {
-                std::ofstream fout(name + ".json");
-                fout << "{\n"
-                        "    \"name\" : \"" << name << "\", " << std::endl <<
-                     "    \"results\" : [\n";
-                for (auto i : outcomes) {
-                    if (i != outcomes.back())
-                        fout << "        " << "{\"" << i.first << "\" : " << i.second << " }, " << std::endl;
-                    else
-                        fout << "        " << "{\"" << i.first << "\" : " << i.second << " } " << std::endl;
-                }
-                fout << "]}" << std::endl;
-            }
+            std::vector<Statistics> outcomes;
         };
 
         auto time_now() noexcept {
@@ -53,18 +132,151 @@ namespace benchmark {
             while (size) v.push_back(size--);
         }
 
-        virtual Result run() = 0;
+        /*
+         * Bracket the measured region of run(size_t). stop() returns the elapsed nanoseconds;
+         * allocations and hardware counters of the region are kept in `sample`.
+         */
+        void start() noexcept {
+            auto &stats = allocation_stats();
+            allocation_base = stats;
+            stats.peak_live_bytes = stats.live_bytes;
+            if (perf_counters) perf_counters->start();
+            begin = time_now();
+        }
+
+        long long stop() noexcept {
+            auto end = time_now();
+            if (perf_counters) sample.counters = perf_counters->stop();
+            auto &now = allocation_stats();
+            sample.ns = (end - begin).count();
+            sample.allocations = now.allocations - allocation_base.allocations;
+            sample.bytes_allocated = now.bytes_allocated - allocation_base.bytes_allocated;
+            sample.peak_bytes = now.peak_live_bytes - allocation_base.live_bytes;
+            return sample.ns;
+        }
+
+        /*
+         * Perform one operation of the measured region. In latency mode it is timed with the cycle clock
+         * and recorded into the latency histogram of the current size, otherwise this is just f().
+         */
+        template<class F>
+        void timed(F &&f) {
+            if (!latency) {
+                f();
+                return;
+            }
+            auto t = CycleClock::now();
+            f();
+            latency->record(CycleClock::now() - t);
+        }
+
+        /*
+         * Run a single measurement with n elements and return the elapsed nanoseconds.
+         */
+        virtual long long run(size_t n) = 0;
 
-        BenchMark() {
+        /*
+         * Number of operations in the measured region of run(n), used for per operation figures.
+         */
+        virtual size_t operations(size_t n) { return n; }
+
+        Result run(const Options &options);
+
+        Result run(const std::vector<size_t> &sizes, const Options &options);
+
+        explicit BenchMark(std::string name, size_t first = 1, size_t last = 10000)
+                : name(std::move(name)), first(first), last(last) {
             rand.eng.seed(seed);
             benchmarks.push_back(this);
         };
+
+        virtual ~BenchMark() = default;
+
+    private:
+        std::chrono::steady_clock::time_point begin;
+        AllocationStats allocation_base;
+        Sample sample;
+        LatencyHistogram *latency = nullptr;
     };
 
-    void run_all() {
-        for (auto i : benchmarks) {
-            i->run().output();
+    LatencySummary LatencySummary::of(const LatencyHistogram &histogram) {
+        LatencySummary res;
+        res.count = histogram.count();
+        res.mean = histogram.mean() * CycleClock::ns_per_tick();
+        res.p50 = CycleClock::to_ns(histogram.percentile(0.5));
+        res.p90 = CycleClock::to_ns(histogram.percentile(0.9));
+        res.p99 = CycleClock::to_ns(histogram.percentile(0.99));
+        res.p999 = CycleClock::to_ns(histogram.percentile(0.999));
+        res.max = CycleClock::to_ns(histogram.max());
+        return res;
+    }
+
+    Statistics Statistics::of(size_t size, size_t operations, const std::vector<Sample> &samples) {
+        Statistics res;
+        res.size = size;
+        res.operations = operations;
+        if (samples.empty()) return res;
+        for (auto &i : samples) {
+            res.samples.push_back(i.ns);
+            res.allocations += i.allocations;
+            res.bytes_allocated += i.bytes_allocated;
+            res.peak_bytes = std::max(res.peak_bytes, i.peak_bytes);
+            res.peak_rss_kb = std::max(res.peak_rss_kb, i.peak_rss_kb);
+            for (size_t j = 0; j < PerfCounters::EVENT_COUNT; ++j) res.counters[j] += i.counters[j];
+        }
+        res.allocations /= samples.size();
+        res.bytes_allocated /= samples.size();
+        for (auto &i : res.counters) i /= samples.size();
+        auto sorted = res.samples;
+        std::sort(sorted.begin(), sorted.end());
+        auto rank = [&](double p) {
+            auto k = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[k ? k - 1 : 0];
+        };
+        res.min = sorted.front();
+        res.max = sorted.back();
+        res.median = rank(0.5);
+        res.p90 = rank(0.9);
+        res.p99 = rank(0.99);
+        double sum = 0, square = 0;
+        for (auto i : sorted) sum += i;
+        res.mean = sum / sorted.size();
+        for (auto i : sorted) square += (i - res.mean) * (i - res.mean);
+        res.stddev = sorted.size() > 1 ? std::sqrt(square / (sorted.size() - 1)) : 0;
+        return res;
+    }
+
+    BenchMark::Result BenchMark::run(const Options &options) {
+        std::vector<size_t> sizes;
+        auto lo = std::max(first, options.min_size), hi = std::min(last, options.max_size);
+        for (auto i = lo; i <= hi; i += options.step) sizes.push_back(i);
+        return run(sizes, options);
+    }
+
+    BenchMark::Result BenchMark::run(const std::vector<size_t> &sizes, const Options &options) {
+        Result result;
+        result.name = name;
+        // 15KB, kept off the stack
+        auto histogram = options.latency ? std::make_unique<LatencyHistogram>() : nullptr;
+        for (auto i : sizes) {
+            if (i < options.min_size || i > options.max_size) continue;
+            for (size_t j = 0; j < options.warmup; ++j) run(i);
+            std::vector<Sample> samples;
+            samples.reserve(options.repetitions);
+            if (histogram) histogram->clear();
+            latency = histogram.get();
+            for (size_t j = 0; j < options.repetitions; ++j) {
+                sample = Sample{};
+                auto rss = reset_peak_rss();
+                sample.ns = run(i);
+                if (rss) sample.peak_rss_kb = peak_rss_kb();
+                samples.push_back(sample);
+            }
+            latency = nullptr;
+            result.outcomes.push_back(Statistics::of(i, operations(i), samples));
+            if (histogram) result.outcomes.back().latency = LatencySummary::of(*histogram);
         }
+        return result;
     }
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_BENCHMARK_H
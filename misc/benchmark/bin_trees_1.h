@@ -7,6 +7,7 @@
 
 #include "benchmark.h"
 #include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
 #include <rb_tree.hpp>
 #include <splay.hpp>
 #include <treap.hpp>
@@ -16,40 +17,21 @@
 namespace benchmark {
     using namespace data_structure;
 
-    struct TreeRunner : public BenchMark {
-        std::string name;
-
-        explicit TreeRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-
-
     template<class Tree>
-    struct OrderedInsertionRunner : public TreeRunner {
+    struct OrderedInsertionRunner : public BenchMark {
 
 
-        explicit OrderedInsertionRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        explicit OrderedInsertionRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> order_int_vec;
             gen_ordered_int(order_int_vec, n);
-            auto a = time_now();
+            start();
             for (auto i : order_int_vec) {
-                tree.insert(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { tree.insert(i); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -58,6 +40,7 @@ namespace benchmark {
     OrderedInsertionRunner<Splay<int>> splay_ordered_insertion("SplayTreeOrderedInsertion");
     OrderedInsertionRunner<Treap<int>> treap_ordered_insertion("TreapTreeOrderedInsertion");
     OrderedInsertionRunner<ScapeGoat<int>> scapegoat_ordered_insertion("ScapegoatTreeOrderedInsertion");
+    OrderedInsertionRunner<BPlusTree<int>> b_plus_tree_ordered_insertion("BPlusTreeOrderedInsertion");
     OrderedInsertionRunner<std::set<int>> set_ordered_insertion("SetTreeOrderedInsertion");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_1
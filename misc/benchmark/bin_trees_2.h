@@ -7,6 +7,7 @@
 
 #include "benchmark.h"
 #include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
 #include <rb_tree.hpp>
 #include <splay.hpp>
 #include <treap.hpp>
@@ -16,42 +17,21 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_1
-    struct TreeRunner : public BenchMark {
-        std::string name;
-
-        explicit TreeRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class Tree>
-    struct RandomInsertionRunner : public TreeRunner {
+    struct RandomInsertionRunner : public BenchMark {
 
 
-        explicit RandomInsertionRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        explicit RandomInsertionRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                tree.insert(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { tree.insert(i); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -60,6 +40,7 @@ namespace benchmark {
     RandomInsertionRunner<Splay<int>> splay_random_insertion("SplayTreeRandomInsertion");
     RandomInsertionRunner<Treap<int>> treap_random_insertion("TreapTreeRandomInsertion");
     RandomInsertionRunner<ScapeGoat<int>> scapegoat_random_insertion("ScapegoatTreeRandomInsertion");
+    RandomInsertionRunner<BPlusTree<int>> b_plus_tree_random_insertion("BPlusTreeRandomInsertion");
     RandomInsertionRunner<std::set<int>> set_random_insertion("SetTreeRandomInsertion");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_2
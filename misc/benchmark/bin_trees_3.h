@@ -7,6 +7,7 @@
 
 #include "benchmark.h"
 #include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
 #include <rb_tree.hpp>
 #include <splay.hpp>
 #include <treap.hpp>
@@ -17,24 +18,13 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_1
-
-    struct TreeRunner : public BenchMark {
-        std::string name;
-
-        explicit TreeRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class Tree>
-    struct RandomDeletionRunner : public TreeRunner {
+    struct RandomDeletionRunner : public BenchMark {
 
 
-        explicit RandomDeletionRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        explicit RandomDeletionRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -43,22 +33,11 @@ namespace benchmark {
                 tree.insert(i);
             }
             std::random_shuffle(vec.begin(), vec.end());
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                tree.erase(i);
+                timed([&] { tree.erase(i); });
             }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
@@ -67,15 +46,16 @@ namespace benchmark {
     RandomDeletionRunner<Splay<int>> splay_random_deletion("SplayTreeRandomDeletion");
     RandomDeletionRunner<Treap<int>> treap_random_deletion("TreapTreeRandomDeletion");
     RandomDeletionRunner<ScapeGoat<int>> scapegoat_random_deletion("ScapegoatTreeRandomDeletion");
+    RandomDeletionRunner<BPlusTree<int>> b_plus_tree_random_deletion("BPlusTreeRandomDeletion");
     RandomDeletionRunner<std::set<int>> set_random_deletion("SetTreeRandomDeletion");
 
     template<class Tree>
-    struct IterationRunner : public TreeRunner {
+    struct IterationRunner : public BenchMark {
 
 
-        explicit IterationRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        explicit IterationRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -84,23 +64,12 @@ namespace benchmark {
                 tree.insert(i);
             }
             std::random_shuffle(vec.begin(), vec.end());
-            auto a = time_now();
+            start();
             auto m = tree.begin();
             while (m != tree.end()) {
-                ++m;
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { do_not_optimize(*m++); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -109,6 +78,7 @@ namespace benchmark {
     IterationRunner<Splay<int>> splay_iteration("SplayTreeIteration");
     IterationRunner<Treap<int>> treap_iteration("TreapTreeIteration");
     IterationRunner<ScapeGoat<int>> scapegoat_iteration("ScapegoatTreeIteration");
+    IterationRunner<BPlusTree<int>> b_plus_tree_iteration("BPlusTreeIteration");
     IterationRunner<std::set<int>> set_iteration("SetTreeIteration");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_3
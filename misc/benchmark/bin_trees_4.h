@@ -7,6 +7,7 @@
 
 #include "benchmark.h"
 #include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
 #include <rb_tree.hpp>
 #include <splay.hpp>
 #include <treap.hpp>
@@ -17,24 +18,13 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_1
-
-    struct TreeRunner : public BenchMark {
-        std::string name;
-
-        explicit TreeRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class Tree>
-    struct CheckingRunner : public TreeRunner {
+    struct CheckingRunner : public BenchMark {
 
 
-        explicit CheckingRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        explicit CheckingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -42,30 +32,19 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < vec.size(); ++i) {
-                tree.contains(rand());
+                timed([&] { do_not_optimize(tree.contains(rand())); });
             }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
     template<>
-    struct CheckingRunner<std::set<int>> : public TreeRunner {
-        explicit CheckingRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+    struct CheckingRunner<std::set<int>> : public BenchMark {
+        explicit CheckingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::set<int> tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -73,22 +52,11 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < vec.size(); ++i) {
-                tree.count(rand());
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { do_not_optimize(tree.count(rand())); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -97,16 +65,19 @@ namespace benchmark {
     CheckingRunner<Splay<int>> splay_checking("SplayTreeChecking");
     CheckingRunner<Treap<int>> treap_checking("TreapTreeChecking");
     CheckingRunner<ScapeGoat<int>> scapegoat_checking("ScapegoatTreeChecking");
+    CheckingRunner<BPlusTree<int>> b_plus_tree_checking("BPlusTreeChecking");
     CheckingRunner<std::set<int>> set_checking("SetTreeChecking");
 
 
     template<class Tree>
-    struct OrderedCheckingRunner : public TreeRunner {
+    struct OrderedCheckingRunner : public BenchMark {
+
 
+        explicit OrderedCheckingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        explicit OrderedCheckingRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+        size_t operations(size_t n) override { return 100'000; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Tree tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -114,30 +85,21 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < 100'000; ++i) {
-                tree.contains(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { do_not_optimize(tree.contains(i)); });
             }
-            return result;
+            return stop();
         }
     };
 
     template<>
-    struct OrderedCheckingRunner<std::set<int>> : public TreeRunner {
-        explicit OrderedCheckingRunner(std::string name) noexcept : TreeRunner(std::move(name)) {}
+    struct OrderedCheckingRunner<std::set<int>> : public BenchMark {
+        explicit OrderedCheckingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override { return 100'000; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::set<int> tree;
             std::vector<int> vec;
             gen_random_int(vec, n);
@@ -145,22 +107,11 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < 100'000; ++i) {
-                tree.count(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { do_not_optimize(tree.count(i)); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -169,6 +120,7 @@ namespace benchmark {
     OrderedCheckingRunner<Splay<int>> splay_ordered_checking("SplayTreeOrderedChecking");
     OrderedCheckingRunner<Treap<int>> treap_ordered_checking("TreapTreeOrderedChecking");
     OrderedCheckingRunner<ScapeGoat<int>> scapegoat_ordered_checking("ScapegoatTreeOrderedChecking");
+    OrderedCheckingRunner<BPlusTree<int>> b_plus_tree_ordered_checking("BPlusTreeOrderedChecking");
     OrderedCheckingRunner<std::set<int>> set_ordered_checking("SetTreeOrderedChecking");
 
 }
@@ -0,0 +1,188 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_5
+#define DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_5
+
+#include "benchmark.h"
+#include "workload.h"
+#include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
+#include <rb_tree.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <scapegoat.hpp>
+#include <functional>
+#include <set>
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * Insert 0..n-1 in random order, then look up n Zipf distributed keys: the access skew favours self adjusting trees.
+     */
+    template<class Tree>
+    struct ZipfCheckingRunner : public BenchMark {
+
+
+        explicit ZipfCheckingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        long long run(size_t n) override {
+            Tree tree;
+            for (auto i : workload::permutation(rand.eng, n)) {
+                tree.insert(i);
+            }
+            auto queries = workload::zipf(rand.eng, n, n);
+            size_t found = 0;
+            start();
+            for (auto i : queries) {
+                timed([&] { found += workload::lookup(tree, i); });
+            }
+            do_not_optimize(found);
+            return stop();
+        }
+    };
+
+    ZipfCheckingRunner<AVLTree<int>> avl_zipf_checking("AVLTreeZipfChecking");
+    ZipfCheckingRunner<RbTree<int>> rb_zipf_checking("RbTreeZipfChecking");
+    ZipfCheckingRunner<Splay<int>> splay_zipf_checking("SplayTreeZipfChecking");
+    ZipfCheckingRunner<Treap<int>> treap_zipf_checking("TreapTreeZipfChecking");
+    ZipfCheckingRunner<ScapeGoat<int>> scapegoat_zipf_checking("ScapegoatTreeZipfChecking");
+    ZipfCheckingRunner<BPlusTree<int>> b_plus_tree_zipf_checking("BPlusTreeZipfChecking");
+    ZipfCheckingRunner<std::set<int>> set_zipf_checking("SetTreeZipfChecking");
+
+    /*
+     * Insert a permutation of 0..n-1 produced by one of the shaped generators.
+     */
+    template<class Tree>
+    struct PatternInsertionRunner : public BenchMark {
+        std::function<std::vector<int>(workload::Engine &, size_t)> pattern;
+
+        PatternInsertionRunner(std::string name, std::function<std::vector<int>(workload::Engine &, size_t)> pattern)
+                : BenchMark(std::move(name)), pattern(std::move(pattern)) {}
+
+        long long run(size_t n) override {
+            Tree tree;
+            auto vec = pattern(rand.eng, n);
+            start();
+            for (auto i : vec) {
+                timed([&] { tree.insert(i); });
+            }
+            return stop();
+        }
+    };
+
+    inline std::vector<int> nearly_sorted_pattern(workload::Engine &eng, size_t n) {
+        return workload::nearly_sorted(eng, n);
+    }
+
+    inline std::vector<int> sawtooth_pattern(workload::Engine &, size_t n) {
+        return workload::sawtooth(n);
+    }
+
+    inline std::vector<int> adversarial_pattern(workload::Engine &, size_t n) {
+        return workload::adversarial(n);
+    }
+
+    PatternInsertionRunner<AVLTree<int>> avl_nearly_sorted("AVLTreeNearlySortedInsertion", nearly_sorted_pattern);
+    PatternInsertionRunner<RbTree<int>> rb_nearly_sorted("RbTreeNearlySortedInsertion", nearly_sorted_pattern);
+    PatternInsertionRunner<Splay<int>> splay_nearly_sorted("SplayTreeNearlySortedInsertion", nearly_sorted_pattern);
+    PatternInsertionRunner<Treap<int>> treap_nearly_sorted("TreapTreeNearlySortedInsertion", nearly_sorted_pattern);
+    PatternInsertionRunner<ScapeGoat<int>> scapegoat_nearly_sorted("ScapegoatTreeNearlySortedInsertion",
+                                                                   nearly_sorted_pattern);
+    PatternInsertionRunner<BPlusTree<int>> b_plus_tree_nearly_sorted("BPlusTreeNearlySortedInsertion",
+                                                                     nearly_sorted_pattern);
+    PatternInsertionRunner<std::set<int>> set_nearly_sorted("SetTreeNearlySortedInsertion", nearly_sorted_pattern);
+
+    PatternInsertionRunner<AVLTree<int>> avl_sawtooth("AVLTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<RbTree<int>> rb_sawtooth("RbTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<Splay<int>> splay_sawtooth("SplayTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<Treap<int>> treap_sawtooth("TreapTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<ScapeGoat<int>> scapegoat_sawtooth("ScapegoatTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<BPlusTree<int>> b_plus_tree_sawtooth("BPlusTreeSawtoothInsertion", sawtooth_pattern);
+    PatternInsertionRunner<std::set<int>> set_sawtooth("SetTreeSawtoothInsertion", sawtooth_pattern);
+
+    PatternInsertionRunner<AVLTree<int>> avl_adversarial("AVLTreeAdversarialInsertion", adversarial_pattern);
+    PatternInsertionRunner<RbTree<int>> rb_adversarial("RbTreeAdversarialInsertion", adversarial_pattern);
+    PatternInsertionRunner<Splay<int>> splay_adversarial("SplayTreeAdversarialInsertion", adversarial_pattern);
+    PatternInsertionRunner<Treap<int>> treap_adversarial("TreapTreeAdversarialInsertion", adversarial_pattern);
+    PatternInsertionRunner<ScapeGoat<int>> scapegoat_adversarial("ScapegoatTreeAdversarialInsertion",
+                                                                 adversarial_pattern);
+    PatternInsertionRunner<BPlusTree<int>> b_plus_tree_adversarial("BPlusTreeAdversarialInsertion",
+                                                                   adversarial_pattern);
+    PatternInsertionRunner<std::set<int>> set_adversarial("SetTreeAdversarialInsertion", adversarial_pattern);
+
+    /*
+     * Start from n random keys of [0, 2n), then run n operations on Zipf distributed keys,
+     * 70% lookups, 20% insertions and 10% deletions.
+     */
+    template<class Tree>
+    struct MixedTraceRunner : public BenchMark {
+
+
+        explicit MixedTraceRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        long long run(size_t n) override {
+            Tree tree;
+            for (auto i : workload::uniform(rand.eng, n, 2 * n)) {
+                tree.insert(i);
+            }
+            auto ops = workload::trace(rand.eng, workload::zipf(rand.eng, n, 2 * n), {0.7, 0.2, 0.1});
+            size_t hits = 0;
+            start();
+            for (auto &i : ops) {
+                timed([&] { hits += workload::apply(tree, i.op, i.key); });
+            }
+            do_not_optimize(hits);
+            return stop();
+        }
+    };
+
+    MixedTraceRunner<AVLTree<int>> avl_mixed_trace("AVLTreeMixedTrace");
+    MixedTraceRunner<RbTree<int>> rb_mixed_trace("RbTreeMixedTrace");
+    MixedTraceRunner<Splay<int>> splay_mixed_trace("SplayTreeMixedTrace");
+    MixedTraceRunner<Treap<int>> treap_mixed_trace("TreapTreeMixedTrace");
+    MixedTraceRunner<ScapeGoat<int>> scapegoat_mixed_trace("ScapegoatTreeMixedTrace");
+    MixedTraceRunner<BPlusTree<int>> b_plus_tree_mixed_trace("BPlusTreeMixedTrace");
+    MixedTraceRunner<std::set<int>> set_mixed_trace("SetTreeMixedTrace");
+    /*
+     * A sliding window median: keys come from a permutation of [0, 2n), the window holds the latest n of them and
+     * every step inserts one key, erases the oldest one and takes the median. The weighted trees select it in
+     * O(log n); `Scan` walks the iterators to it in O(n), as done without the subtree sizes.
+     */
+    template<class Tree, bool Scan = false>
+    struct SlidingMedianRunner : public BenchMark {
+
+
+        explicit SlidingMedianRunner(std::string name) noexcept : BenchMark(std::move(name), 1, Scan ? 2000 : 10000) {}
+
+        long long run(size_t n) override {
+            Tree tree;
+            auto keys = workload::permutation(rand.eng, 2 * n);
+            for (size_t i = 0; i < n; ++i) {
+                tree.insert(keys[i]);
+            }
+            long long sum = 0;
+            start();
+            for (auto i = n; i < 2 * n; ++i) {
+                timed([&] {
+                    tree.insert(keys[i]);
+                    tree.erase(keys[i - n]);
+                    if constexpr (Scan) {
+                        auto it = tree.begin();
+                        for (auto k = tree.size() / 2; k; --k) ++it;
+                        sum += *it;
+                    } else sum += *tree.select(tree.size() / 2);
+                });
+            }
+            do_not_optimize(sum);
+            return stop();
+        }
+    };
+
+    SlidingMedianRunner<AVLTree<int, AVLNode<int, WeightedBSTNode<int>>>> avl_sliding_median("AVLTreeSlidingMedian");
+    SlidingMedianRunner<RbTree<int, RBTNode<int, WeightedBSTNode<int>>>> rb_sliding_median("RbTreeSlidingMedian");
+    SlidingMedianRunner<Treap<int, TreapNode<int, WeightedBSTNode<int>>>> treap_sliding_median(
+            "TreapTreeSlidingMedian");
+    SlidingMedianRunner<ScapeGoat<int>> scapegoat_sliding_median("ScapegoatTreeSlidingMedian");
+    SlidingMedianRunner<RbTree<int>, true> rb_sliding_median_scan("RbTreeSlidingMedianScan");
+    SlidingMedianRunner<std::set<int>, true> set_sliding_median_scan("SetTreeSlidingMedianScan");
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_5
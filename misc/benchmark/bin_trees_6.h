@@ -0,0 +1,127 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_6
+#define DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_6
+
+#include "benchmark.h"
+#include <augmented_tree.hpp>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace benchmark {
+    using namespace data_structure;
+
+    // the baseline of the interval benchmarks: intervals ordered by start, scanned up to the end of the query
+    struct IntervalScan {
+        std::set<std::pair<int, int>> set;
+
+        bool insert(int lo, int hi) { return set.insert({lo, hi}).second; }
+
+        bool erase(int lo, int hi) { return set.erase({lo, hi}); }
+
+        std::vector<Interval<int>> overlapping(int lo, int hi) {
+            std::vector<Interval<int>> res;
+            for (auto it = set.begin(); it != set.end() && it->first <= hi; ++it) {
+                if (lo <= it->second) res.push_back({it->first, it->second});
+            }
+            return res;
+        }
+    };
+
+    /*
+     * Time ranges: n intervals start at random points of [0, 16n) and last less than 64. Every operation replaces a
+     * random interval by a new one and reports the intervals overlapping a window of length 32, a handful at most.
+     */
+    template<class Intervals>
+    struct IntervalOverlapRunner : public BenchMark {
+
+
+        explicit IntervalOverlapRunner(std::string name, size_t last = 10000) noexcept
+                : BenchMark(std::move(name), 1, last) {}
+
+        long long run(size_t n) override {
+            Intervals intervals;
+            std::vector<int> vec;
+            gen_random_int(vec, 5 * n);
+            auto start_of = [&](size_t i) { return static_cast<int>(static_cast<unsigned>(vec[i]) % (16 * n)); };
+            auto length_of = [&](size_t i) { return static_cast<int>(static_cast<unsigned>(vec[i]) % 64); };
+            std::vector<std::pair<int, int>> live;
+            for (size_t i = 0; i < n; ++i) {
+                live.emplace_back(start_of(i), start_of(i) + length_of(n + i));
+                intervals.insert(live.back().first, live.back().second);
+            }
+            size_t found = 0;
+            start();
+            for (size_t i = 0; i < n; ++i) {
+                timed([&] {
+                    auto &old = live[static_cast<unsigned>(vec[2 * n + i]) % n];
+                    intervals.erase(old.first, old.second);
+                    old = {start_of(3 * n + i), start_of(3 * n + i) + length_of(4 * n + i)};
+                    intervals.insert(old.first, old.second);
+                    found += intervals.overlapping(start_of(4 * n + i), start_of(4 * n + i) + 31).size();
+                });
+            }
+            do_not_optimize(found);
+            return stop();
+        }
+    };
+
+    IntervalOverlapRunner<IntervalTree<int>> rb_interval_overlap("RbTreeIntervalOverlap");
+    IntervalOverlapRunner<IntervalTree<int, AugmentedAVLTree>> avl_interval_overlap("AVLTreeIntervalOverlap");
+    IntervalOverlapRunner<IntervalTree<int, AugmentedTreap>> treap_interval_overlap("TreapTreeIntervalOverlap");
+    IntervalOverlapRunner<IntervalTree<int, AugmentedSplay>> splay_interval_overlap("SplayTreeIntervalOverlap");
+    IntervalOverlapRunner<IntervalScan> set_interval_overlap("SetTreeIntervalOverlap", 2000);
+
+    // the baseline of the range sums: a std::map whose ranges are summed by walking them
+    struct RangeSumScan {
+        std::map<int, long long> map;
+
+        void assign(int k, long long v) { map[k] = v; }
+
+        long long aggregate(int lo, int hi) {
+            long long sum = 0;
+            for (auto it = map.lower_bound(lo); it != map.end() && it->first <= hi; ++it) sum += it->second;
+            return sum;
+        }
+    };
+
+    /*
+     * n keys of [0, 2n) with values, then n steps that each overwrite one value and sum the values of a random key
+     * range covering an eighth of the universe.
+     */
+    template<class Map>
+    struct RangeSumRunner : public BenchMark {
+
+
+        explicit RangeSumRunner(std::string name, size_t last = 10000) noexcept
+                : BenchMark(std::move(name), 1, last) {}
+
+        long long run(size_t n) override {
+            Map map;
+            std::vector<int> vec;
+            gen_random_int(vec, 4 * n);
+            auto key_of = [&](size_t i) { return static_cast<int>(static_cast<unsigned>(vec[i]) % (2 * n)); };
+            for (size_t i = 0; i < n; ++i) map.assign(key_of(i), vec[n + i] & 1023);
+            long long sum = 0;
+            start();
+            for (size_t i = 0; i < n; ++i) {
+                timed([&] {
+                    map.assign(key_of(2 * n + i), vec[2 * n + i] & 1023);
+                    auto lo = key_of(3 * n + i);
+                    sum += map.aggregate(lo, lo + static_cast<int>(n / 4));
+                });
+            }
+            do_not_optimize(sum);
+            return stop();
+        }
+    };
+
+    RangeSumRunner<AggregateMap<int, long long>> rb_range_sum("RbTreeRangeSum");
+    RangeSumRunner<AggregateMap<int, long long, SumMonoid<long long>, AugmentedAVLTree>> avl_range_sum(
+            "AVLTreeRangeSum");
+    RangeSumRunner<AggregateMap<int, long long, SumMonoid<long long>, AugmentedTreap>> treap_range_sum(
+            "TreapTreeRangeSum");
+    RangeSumRunner<AggregateMap<int, long long, SumMonoid<long long>, AugmentedSplay>> splay_range_sum(
+            "SplayTreeRangeSum");
+    RangeSumRunner<RangeSumScan> map_range_sum("MapRangeSum", 2000);
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_6
@@ -0,0 +1,59 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_7
+#define DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_7
+
+#include "benchmark.h"
+#include <avl_tree.hpp>
+#include <rb_tree.hpp>
+#include <treap.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * Merging shards: two trees of n random keys of [0, 4n) become their union. `Threads` is the number of threads
+     * unite may use, 0 standing for all of the hardware; the `Insertion` runners insert the keys of the second tree
+     * into the first one by one, and std::set merges node by node.
+     */
+    template<class Tree, size_t Threads = 1, bool Insertion = false>
+    struct UnionRunner : public BenchMark {
+
+
+        explicit UnionRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 100000) {}
+
+        long long run(size_t n) override {
+            Tree a, b;
+            std::vector<int> vec;
+            gen_random_int(vec, 2 * n);
+            for (size_t i = 0; i < n; ++i) {
+                a.insert(static_cast<int>(static_cast<unsigned>(vec[i]) % (4 * n)));
+                b.insert(static_cast<int>(static_cast<unsigned>(vec[n + i]) % (4 * n)));
+            }
+            start();
+            if constexpr (Insertion) {
+                for (auto x : b) a.insert(x);
+            } else if constexpr (std::is_same_v<Tree, std::set<int>>) {
+                a.merge(b);
+            } else {
+                a.unite(b, Threads ? Threads : std::thread::hardware_concurrency());
+            }
+            auto res = stop();
+            do_not_optimize(a.size());
+            return res;
+        }
+    };
+
+    UnionRunner<Treap<int>> treap_union("TreapTreeUnion");
+    UnionRunner<AVLTree<int>> avl_union("AVLTreeUnion");
+    UnionRunner<RbTree<int>> rb_union("RbTreeUnion");
+    UnionRunner<Treap<int>, 0> treap_parallel_union("TreapTreeParallelUnion");
+    UnionRunner<AVLTree<int>, 0> avl_parallel_union("AVLTreeParallelUnion");
+    UnionRunner<RbTree<int>, 0> rb_parallel_union("RbTreeParallelUnion");
+    UnionRunner<Treap<int>, 1, true> treap_union_by_insertion("TreapTreeUnionByInsertion");
+    UnionRunner<AVLTree<int>, 1, true> avl_union_by_insertion("AVLTreeUnionByInsertion");
+    UnionRunner<RbTree<int>, 1, true> rb_union_by_insertion("RbTreeUnionByInsertion");
+    UnionRunner<std::set<int>> set_tree_union("SetTreeUnion");
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_BIN_TREES_H_7
@@ -0,0 +1,164 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_COMPARE_H
+#define DATA_STRUCTURE_FOR_LOVE_COMPARE_H
+
+#include "benchmark.h"
+#include "report.h"
+#include "json.h"
+#include <map>
+#include <iomanip>
+#include <sstream>
+
+namespace benchmark {
+    /*
+     * Samples of a previous run, read back from its JSON output: name -> size -> ns of every recorded run.
+     */
+    using Baseline = std::map<std::string, std::map<size_t, std::vector<long long>>>;
+
+    Baseline load_baseline(const std::string &path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot open baseline " + path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        auto root = json::parse(buffer.str());
+        if (!root.has("schema") || root["schema"].number != schema_version)
+            throw std::runtime_error(path + " is not a schema " + std::to_string(schema_version) + " benchmark file");
+        Baseline res;
+        for (auto &bench : root["benchmarks"].array) {
+            auto &sizes = res[bench["name"].string];
+            for (auto &r : bench["results"].array) {
+                auto &samples = sizes[static_cast<size_t>(r["size"].number)];
+                for (auto &s : r["samples"].array) samples.push_back(static_cast<long long>(s.number));
+            }
+        }
+        return res;
+    }
+
+    /*
+     * One sided Mann-Whitney U test: the probability of seeing a rank sum at least as extreme as the observed one
+     * if `after` were drawn from the same distribution as `before`, against the alternative that `after` is
+     * stochastically larger (slower). The exact distribution is used for small samples without ties,
+     * otherwise the normal approximation with tie and continuity correction.
+     */
+    double mann_whitney_greater(const std::vector<long long> &before, const std::vector<long long> &after) {
+        auto m = after.size(), n = before.size();
+        if (!m || !n) return 1;
+        double u = 0;
+        bool ties = false;
+        for (auto a : after) {
+            for (auto b : before) {
+                if (a > b) u += 1;
+                else if (a == b) u += 0.5, ties = true;
+            }
+        }
+        if (!ties && m <= 20 && n <= 20) {
+            // count[j][k]: arrangements of i `after` and j `before` samples whose U statistic is k, rolled over i;
+            // the largest element is either an `after` sample beating all j `before`s, or a `before` sample
+            std::vector<std::vector<double>> count(n + 1, std::vector<double>(m * n + 1)), next = count;
+            for (auto &j : count) j[0] = 1;
+            for (size_t i = 1; i <= m; ++i) {
+                next[0].assign(m * n + 1, 0);
+                next[0][0] = 1;
+                for (size_t j = 1; j <= n; ++j) {
+                    for (size_t k = 0; k <= m * n; ++k)
+                        next[j][k] = (k >= j ? count[j][k - j] : 0) + next[j - 1][k];
+                }
+                std::swap(count, next);
+            }
+            double total = 0, tail = 0;
+            for (size_t k = 0; k <= m * n; ++k) {
+                total += count[n][k];
+                if (k >= static_cast<size_t>(u)) tail += count[n][k];
+            }
+            return tail / total;
+        }
+        std::vector<std::pair<long long, bool>> all;
+        for (auto a : after) all.emplace_back(a, true);
+        for (auto b : before) all.emplace_back(b, false);
+        std::sort(all.begin(), all.end());
+        double tie_term = 0;
+        for (size_t i = 0, j; i < all.size(); i = j) {
+            for (j = i; j < all.size() && all[j].first == all[i].first; ++j);
+            double t = j - i;
+            tie_term += t * t * t - t;
+        }
+        double total = m + n;
+        double mean = m * n / 2.0;
+        double variance = m * n / 12.0 * ((total + 1) - tie_term / (total * (total - 1)));
+        if (variance <= 0) return 1;
+        double z = (u - mean - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    struct Comparison {
+        std::string name;
+        size_t size;
+        long long before, after; // medians
+        double p_slower, p_faster;
+        bool regression, improvement;
+
+        double ratio() const { return before ? static_cast<double>(after) / before : 1; }
+    };
+
+    /*
+     * Compare every (benchmark, size) of `results` that also appears in the baseline.
+     * A regression needs both statistical significance (p < alpha) and a practically relevant
+     * slowdown of the median (more than `threshold`, relative); improvements are judged symmetrically.
+     */
+    std::vector<Comparison> compare(const Baseline &baseline, const std::vector<BenchMark::Result> &results,
+                                    double alpha, double threshold) {
+        std::vector<Comparison> res;
+        for (auto &result : results) {
+            auto bench = baseline.find(result.name);
+            if (bench == baseline.end()) continue;
+            for (auto &s : result.outcomes) {
+                auto old = bench->second.find(s.size);
+                if (old == bench->second.end() || old->second.empty()) continue;
+                auto sorted = old->second;
+                std::sort(sorted.begin(), sorted.end());
+                Comparison c{result.name, s.size, sorted[(sorted.size() - 1) / 2], s.median,
+                             mann_whitney_greater(old->second, s.samples),
+                             mann_whitney_greater(s.samples, old->second), false, false};
+                c.regression = c.p_slower < alpha && c.ratio() > 1 + threshold;
+                c.improvement = c.p_faster < alpha && c.ratio() < 1 - threshold;
+                res.push_back(c);
+            }
+        }
+        return res;
+    }
+
+    /*
+     * Print every significant change and a one line summary per benchmark. Returns the number of regressions.
+     */
+    size_t print_comparison(std::ostream &out, const std::vector<Comparison> &comparisons) {
+        size_t regressions = 0;
+        std::map<std::string, std::tuple<size_t, size_t, size_t, double>> summary; // slower, faster, total, log ratio
+        auto precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        for (auto &c : comparisons) {
+            auto &[slower, faster, total, log_ratio] = summary[c.name];
+            total++;
+            log_ratio += std::log(std::max(c.ratio(), 1e-9));
+            if (c.regression) {
+                slower++;
+                regressions++;
+                out << "REGRESSION " << c.name << " size " << c.size << ": median " << c.before << "ns -> "
+                    << c.after << "ns (x" << c.ratio() << ", p = " << c.p_slower << ")\n";
+            } else if (c.improvement) {
+                faster++;
+                out << "improved   " << c.name << " size " << c.size << ": median " << c.before << "ns -> "
+                    << c.after << "ns (x" << c.ratio() << ", p = " << c.p_faster << ")\n";
+            }
+        }
+        for (auto &[name, s] : summary) {
+            auto &[slower, faster, total, log_ratio] = s;
+            out << name << ": " << slower << " slower, " << faster << " faster of " << total
+                << " sizes, geometric mean ratio x" << std::exp(log_ratio / total) << "\n";
+        }
+        out << (regressions ? std::to_string(regressions) + " regression(s) against the baseline"
+                            : std::string("no regression against the baseline")) << std::endl;
+        out.unsetf(std::ios::floatfield);
+        out.precision(precision);
+        return regressions;
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_COMPARE_H
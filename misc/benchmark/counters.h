@@ -0,0 +1,171 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_COUNTERS_H
+#define DATA_STRUCTURE_FOR_LOVE_COUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <array>
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+#include <sys/resource.h>
+
+namespace benchmark {
+    /*
+     * Per thread allocation statistics, maintained by the replaced global operator new/delete in allocation_hook.cpp.
+     * Everything allocating through new (TrivialFactory, PoolFactory and ObjectPool chunks, std::allocator) is seen.
+     * live_bytes counts the bytes requested by blocks not yet freed, live_usable_bytes what malloc actually
+     * reserved for them; the difference is the allocator's internal fragmentation.
+     */
+    struct AllocationStats {
+        size_t allocations = 0, deallocations = 0;
+        size_t bytes_allocated = 0;
+        size_t live_bytes = 0, live_usable_bytes = 0, peak_live_bytes = 0;
+
+        size_t live_blocks() const noexcept { return allocations - deallocations; }
+    };
+
+    AllocationStats &allocation_stats() noexcept;
+
+    /*
+     * Peak resident set size of the process since the last successful reset_peak_rss(), in kilobytes. ru_maxrss
+     * never decreases, so on Linux the peak is reset through /proc/self/clear_refs and read back as VmHWM. Where
+     * that is refused reset_peak_rss() returns false, and peak_rss_kb() is the peak of the whole process lifetime.
+     */
+    inline bool reset_peak_rss() noexcept {
+#ifdef __linux__
+        auto file = std::fopen("/proc/self/clear_refs", "w");
+        if (!file) return false;
+        auto ok = std::fputs("5", file) >= 0;
+        return std::fclose(file) == 0 && ok;
+#else
+        return false;
+#endif
+    }
+
+    inline long peak_rss_kb() noexcept {
+#ifdef __linux__
+        if (auto file = std::fopen("/proc/self/status", "r")) {
+            char line[256];
+            long kb = -1;
+            while (kb < 0 && std::fgets(line, sizeof(line), file)) {
+                if (std::sscanf(line, "VmHWM: %ld kB", &kb) != 1) kb = -1;
+            }
+            std::fclose(file);
+            if (kb >= 0) return kb;
+        }
+#endif
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    /*
+     * Hardware counters through perf_event_open. Every event is opened on its own,
+     * so a machine lacking one event (typically L1 misses in virtual machines) still reports the others.
+     * When the kernel refuses perf events completely, available() is false and the values stay zero.
+     */
+    class PerfCounters {
+    public:
+        enum Event {
+            CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, EVENT_COUNT
+        };
+
+        constexpr static const char *names[EVENT_COUNT] = {
+                "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+        };
+
+        using Values = std::array<uint64_t, EVENT_COUNT>;
+
+        PerfCounters();
+
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters &) = delete;
+
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        bool available() const noexcept;
+
+        bool available(Event e) const noexcept { return fds[e] >= 0; }
+
+        void start() noexcept;
+
+        Values stop() noexcept;
+
+    private:
+        int fds[EVENT_COUNT];
+    };
+
+#ifdef __linux__
+
+    inline PerfCounters::PerfCounters() {
+        auto open = [](uint32_t type, uint64_t config) {
+            perf_event_attr attr{};
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        };
+        fds[CYCLES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[INSTRUCTIONS] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[L1D_MISSES] = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                                   (PERF_COUNT_HW_CACHE_OP_READ << 8u) |
+                                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16u));
+        fds[LLC_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds[BRANCH_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    }
+
+    inline PerfCounters::~PerfCounters() {
+        for (auto fd : fds) if (fd >= 0) close(fd);
+    }
+
+    inline bool PerfCounters::available() const noexcept {
+        for (auto fd : fds) if (fd >= 0) return true;
+        return false;
+    }
+
+    inline void PerfCounters::start() noexcept {
+        for (auto fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    inline PerfCounters::Values PerfCounters::stop() noexcept {
+        Values values{};
+        for (auto fd : fds) if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (size_t i = 0; i < EVENT_COUNT; ++i) {
+            if (fds[i] < 0 || read(fds[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t)) values[i] = 0;
+        }
+        return values;
+    }
+
+#else
+
+    inline PerfCounters::PerfCounters() { for (auto &fd : fds) fd = -1; }
+
+    inline PerfCounters::~PerfCounters() = default;
+
+    inline bool PerfCounters::available() const noexcept { return false; }
+
+    inline void PerfCounters::start() noexcept {}
+
+    inline PerfCounters::Values PerfCounters::stop() noexcept { return {}; }
+
+#endif //__linux__
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_COUNTERS_H
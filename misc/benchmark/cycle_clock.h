@@ -0,0 +1,53 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_CYCLE_CLOCK_H
+#define DATA_STRUCTURE_FOR_LOVE_CYCLE_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <x86intrin.h>
+
+#endif
+
+namespace benchmark {
+    /*
+     * Cheap timestamps for timing single operations. On x86 this is the time stamp counter (a few ns per read,
+     * against ~20ns for steady_clock); the lfence keeps earlier instructions from drifting past the read.
+     * Elsewhere it falls back to steady_clock, one tick being one nanosecond.
+     */
+    struct CycleClock {
+        static uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_lfence();
+            auto t = __rdtsc();
+            _mm_lfence();
+            return t;
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+
+        // nanoseconds per tick, measured once against steady_clock
+        static double ns_per_tick() noexcept {
+            static const double ratio = calibrate();
+            return ratio;
+        }
+
+        static double to_ns(double ticks) noexcept { return ticks * ns_per_tick(); }
+
+    private:
+        static double calibrate() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            auto begin = std::chrono::steady_clock::now();
+            auto ticks = now();
+            while (std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(20));
+            auto ns = (std::chrono::steady_clock::now() - begin).count();
+            return static_cast<double>(ns) / (now() - ticks);
+#else
+            return 1;
+#endif
+        }
+    };
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_CYCLE_CLOCK_H
@@ -0,0 +1,236 @@
+// Memory footprint of every container, measured through the allocation hook:
+//     footprint [--min-exp e] [--max-exp e] [--filter name] [--csv]
+// sizes are 10^min-exp .. 10^max-exp elements (3 .. 6 by default, up to 8 when memory allows).
+//
+
+#include "counters.h"
+#include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
+#include <rb_tree.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <scapegoat.hpp>
+#include <skip_list.hpp>
+#include <binary_heap.hpp>
+#include <dary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <fib_heap.hpp>
+#include <pairing_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <min_max_heap.hpp>
+#include <binary_trie.hpp>
+#include <x_fast_trie.hpp>
+#include <y_fast_trie.hpp>
+#include <van_emde_boas.hpp>
+#include <optimized_vector.hpp>
+#include <rootish_stack.hpp>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace benchmark;
+using namespace data_structure;
+
+/*
+ * Live memory of a container holding `elements` ints, including the container object itself.
+ *   bytes, usable:   bytes requested from operator new, and what malloc really reserved for them
+ *   blocks:          live heap blocks; allocations counts every new during the build, reallocations included
+ *   peak:            the most bytes alive at any moment of the build (vector growth, rebuilds)
+ *   retained, fresh: after removing half of the elements, the bytes the container still holds, and the bytes
+ *                    of a container built directly with the remaining number of elements
+ */
+struct Footprint {
+    size_t elements = 0;
+    size_t bytes = 0, usable = 0, blocks = 0, allocations = 0, peak = 0;
+    size_t retained = 0, fresh = 0;
+    size_t leaked = 0;
+
+    double per_element(size_t value) const noexcept { return elements ? static_cast<double>(value) / elements : 0; }
+
+    // share of malloc's reservation that is padding and size class rounding
+    double slack() const noexcept { return bytes ? static_cast<double>(usable - bytes) / bytes : 0; }
+
+    // share of the memory retained after the removals that a fresh container would not need
+    double fragmentation() const noexcept {
+        return retained ? 1 - static_cast<double>(fresh) / retained : 0;
+    }
+};
+
+// every operation returns the heap memory of the calling thread to the state before it
+struct SetOps {
+    template<class Set>
+    static void add(Set &set, int key) { set.insert(key); }
+
+    template<class Set>
+    static void remove(Set &set, int key) { set.erase(key); }
+};
+
+struct HeapOps {
+    template<class Heap>
+    static void add(Heap &heap, int key) { heap.push(key); }
+
+    template<class Heap>
+    static void remove(Heap &heap, int) { heap.pop(); }
+};
+
+struct SequenceOps {
+    template<class Seq>
+    static void add(Seq &seq, int key) { seq.push_back(key); }
+
+    template<class Seq>
+    static auto remove(Seq &seq, int, int) -> decltype(seq.pop_back()) { seq.pop_back(); }
+
+    template<class Seq>
+    static void remove(Seq &seq, int, long) { seq.erase(seq.size() - 1); }
+
+    template<class Seq>
+    static void remove(Seq &seq, int key) { remove(seq, key, 0); }
+};
+
+template<class Container, class Ops>
+size_t build(std::unique_ptr<Container> &c, const int *first, const int *last) {
+    auto &stats = allocation_stats();
+    auto before = stats.live_bytes;
+    c = std::make_unique<Container>();
+    for (auto i = first; i != last; ++i) Ops::add(*c, *i);
+    return stats.live_bytes - before;
+}
+
+template<class Container, class Ops>
+Footprint measure(const std::vector<int> &keys) {
+    auto &stats = allocation_stats();
+    auto base = stats;
+    auto n = keys.size(), half = n / 2;
+    Footprint res;
+    res.elements = n;
+    stats.peak_live_bytes = stats.live_bytes;
+    {
+        std::unique_ptr<Container> c;
+        res.bytes = build<Container, Ops>(c, keys.data(), keys.data() + n);
+        res.usable = stats.live_usable_bytes - base.live_usable_bytes;
+        res.blocks = stats.live_blocks() - base.live_blocks();
+        res.allocations = stats.allocations - base.allocations;
+        res.peak = stats.peak_live_bytes - base.live_bytes;
+        for (size_t i = 0; i < half; ++i) Ops::remove(*c, keys[i]);
+        res.retained = stats.live_bytes - base.live_bytes;
+    }
+    {
+        std::unique_ptr<Container> c;
+        res.fresh = build<Container, Ops>(c, keys.data() + half, keys.data() + n);
+    }
+    res.leaked = stats.live_bytes - base.live_bytes;
+    return res;
+}
+
+template<class Set>
+Footprint set(const std::vector<int> &keys) { return measure<Set, SetOps>(keys); }
+
+template<class Heap>
+Footprint heap(const std::vector<int> &keys) { return measure<Heap, HeapOps>(keys); }
+
+template<class Seq>
+Footprint sequence(const std::vector<int> &keys) { return measure<Seq, SequenceOps>(keys); }
+
+const std::vector<std::pair<std::string, std::function<Footprint(const std::vector<int> &)>>> structures = {
+        {"RbTree",              set<RbTree<int>>},
+        {"AVLTree",             set<AVLTree<int>>},
+        {"Treap",               set<Treap<int>>},
+        {"Splay",               set<Splay<int>>},
+        {"ScapeGoat",           set<ScapeGoat<int>>},
+        {"BPlusTree",           set<BPlusTree<int>>},
+        {"SkipList",            set<SkipList<int>>},
+        {"std::set",            set<std::set<int>>},
+        {"BinaryTrie",          set<BinaryTrie<int>>},
+        {"XFastTrie",           set<XFastTrie<int>>},
+        {"YFastTrie",           set<YFastTrie<int>>},
+        {"VebTree",             set<VebTree<int>>},
+        {"BinaryHeap",          heap<BinaryHeap<int>>},
+        {"4AryHeap",            heap<DaryHeap<int, 4>>},
+        {"8AryHeap",            heap<DaryHeap<int, 8>>},
+        {"BinomialHeap",        heap<BinomialHeap<int>>},
+        {"FibHeap",             heap<FibHeap<int>>},
+        {"PairingHeap",         heap<PairingHeap<int>>},
+        {"IndexedBinaryHeap",   heap<IndexedBinaryHeap<int>>},
+        {"MinMaxHeap",          heap<MinMaxHeap<int>>},
+        {"std::priority_queue", heap<std::priority_queue<int>>},
+        {"std::vector",         sequence<std::vector<int>>},
+        {"optimized_vector",    sequence<optimized_vector<int>>},
+        {"RootishStack",        sequence<RootishStack<int>>},
+};
+
+// distinct keys spread over the whole non negative int range: multiplying by an odd constant is a bijection mod 2^31
+std::vector<int> scrambled_keys(size_t n) {
+    std::vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int>((i * 2654435761u) & 0x7fffffffu);
+    return keys;
+}
+
+void usage() {
+    std::cerr << "usage: footprint [--min-exp e] [--max-exp e] [--filter name] [--csv]\n"
+              << "structures:";
+    for (auto &i : structures) std::cerr << " " << i.first;
+    std::cerr << std::endl;
+}
+
+void print_header(bool csv) {
+    if (csv) {
+        std::cout << "structure,elements,bytes,usable_bytes,blocks,allocations,peak_bytes,retained_bytes,fresh_bytes,"
+                     "bytes_per_element,overhead_per_element,slack,fragmentation\n";
+        return;
+    }
+    std::cout << std::left << std::setw(20) << "structure" << std::right << std::setw(11) << "elements"
+              << std::setw(11) << "B/elem" << std::setw(11) << "overhead" << std::setw(11) << "peak/elem"
+              << std::setw(11) << "blocks" << std::setw(12) << "allocs" << std::setw(9) << "slack"
+              << std::setw(10) << "frag" << "\n";
+}
+
+void print(const std::string &name, const Footprint &f, bool csv) {
+    auto overhead = f.per_element(f.bytes) - static_cast<double>(sizeof(int));
+    if (csv) {
+        std::cout << name << "," << f.elements << "," << f.bytes << "," << f.usable << "," << f.blocks << ","
+                  << f.allocations << "," << f.peak << "," << f.retained << "," << f.fresh << ","
+                  << f.per_element(f.bytes) << "," << overhead << "," << f.slack() << "," << f.fragmentation()
+                  << "\n";
+        return;
+    }
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(11) << f.elements << std::setw(11) << f.per_element(f.bytes)
+              << std::setw(11) << overhead << std::setw(11) << f.per_element(f.peak)
+              << std::setw(11) << f.blocks << std::setw(12) << f.allocations
+              << std::setw(8) << f.slack() * 100 << "%" << std::setw(9) << f.fragmentation() * 100 << "%\n";
+}
+
+int main(int argc, char **argv) {
+    int min_exp = 3, max_exp = 6;
+    std::string filter;
+    bool csv = false;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--csv") csv = true;
+        else if (i + 1 == args.size()) return usage(), 1;
+        else if (args[i] == "--min-exp") min_exp = std::stoi(args[++i]);
+        else if (args[i] == "--max-exp") max_exp = std::stoi(args[++i]);
+        else if (args[i] == "--filter") filter = args[++i];
+        else return usage(), 1;
+    }
+    if (min_exp < 0 || max_exp > 9 || min_exp > max_exp) return usage(), 1;
+    print_header(csv);
+    for (int e = min_exp; e <= max_exp; ++e) {
+        size_t n = 1;
+        for (int i = 0; i < e; ++i) n *= 10;
+        auto keys = scrambled_keys(n);
+        for (auto &[name, measure] : structures) {
+            if (name.find(filter) == std::string::npos) continue;
+            auto f = measure(keys);
+            print(name, f, csv);
+            std::cout.flush();
+            if (f.leaked) std::cerr << "warning: " << name << " leaked " << f.leaked << " bytes" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,289 @@
+// The tree, heap and integer set suites as Google Benchmark fixtures, for dashboards built on that library:
+//     gbench --benchmark_filter='RbTree' --benchmark_format=json
+// Benchmarks carry the names of the in-house suites (`<Name>/<size>`), draw their keys from the same workload
+// generators and report items_per_second, so the two harnesses can be put side by side.
+//
+
+#include <benchmark/benchmark.h>
+#include "workload.h"
+#include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
+#include <rb_tree.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <scapegoat.hpp>
+#include <binary_heap.hpp>
+#include <dary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <fib_heap.hpp>
+#include <pairing_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <min_max_heap.hpp>
+#include <van_emde_boas.hpp>
+#include <x_fast_trie.hpp>
+#include <y_fast_trie.hpp>
+#include <binary_trie.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <string>
+
+using namespace data_structure;
+namespace workload = benchmark::workload;
+
+// every size gets its own, fixed key sequence; DSFL_SEED overrides the seed
+workload::Engine engine(int64_t n) {
+    static const auto seed = std::getenv("DSFL_SEED") ? std::strtoull(std::getenv("DSFL_SEED"), nullptr, 10) : 0x5eedu;
+    return workload::Engine(seed ^ static_cast<uint64_t>(n) * 0x9e3779b97f4a7c15ull);
+}
+
+std::vector<int> random_keys(int64_t n, int64_t salt = 0) {
+    auto eng = engine(n + salt);
+    return workload::uniform<int>(eng, static_cast<size_t>(n), INT_MAX);
+}
+
+// the timed loops build into a fresh container; setting it up and tearing it down is kept out of the timing
+template<class Container>
+void paused_reset(benchmark::State &state, std::unique_ptr<Container> &c) {
+    state.PauseTiming();
+    c = std::make_unique<Container>();
+    state.ResumeTiming();
+}
+
+template<class Tree>
+void random_insertion(benchmark::State &state) {
+    auto keys = random_keys(state.range(0));
+    std::unique_ptr<Tree> tree;
+    for (auto _ : state) {
+        paused_reset(state, tree);
+        for (auto k : keys) tree->insert(k);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void ordered_insertion(benchmark::State &state) {
+    // n, n - 1, ..., 1 like BenchMark::gen_ordered_int
+    std::vector<int> keys(state.range(0));
+    std::iota(keys.rbegin(), keys.rend(), 1);
+    std::unique_ptr<Tree> tree;
+    for (auto _ : state) {
+        paused_reset(state, tree);
+        for (auto k : keys) tree->insert(k);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void random_deletion(benchmark::State &state) {
+    auto keys = random_keys(state.range(0));
+    auto order = keys;
+    auto eng = engine(state.range(0));
+    std::shuffle(order.begin(), order.end(), eng);
+    std::unique_ptr<Tree> tree;
+    for (auto _ : state) {
+        state.PauseTiming();
+        tree = std::make_unique<Tree>();
+        for (auto k : keys) tree->insert(k);
+        state.ResumeTiming();
+        for (auto k : order) benchmark::DoNotOptimize(tree->erase(k));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void checking(benchmark::State &state) {
+    Tree tree;
+    for (auto k : random_keys(state.range(0))) tree.insert(k);
+    auto probes = random_keys(state.range(0), 1);
+    for (auto _ : state) {
+        for (auto k : probes) benchmark::DoNotOptimize(workload::lookup(tree, k));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void zipf_checking(benchmark::State &state) {
+    Tree tree;
+    auto n = static_cast<size_t>(state.range(0));
+    auto eng = engine(state.range(0));
+    for (auto k : workload::permutation<int>(eng, n)) tree.insert(k);
+    auto probes = workload::zipf<int>(eng, n, n);
+    for (auto _ : state) {
+        for (auto k : probes) benchmark::DoNotOptimize(workload::lookup(tree, k));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void iteration(benchmark::State &state) {
+    Tree tree;
+    for (auto k : random_keys(state.range(0))) tree.insert(k);
+    for (auto _ : state) {
+        for (auto i = tree.begin(); i != tree.end(); ++i) benchmark::DoNotOptimize(*i);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Tree>
+void mixed_trace(benchmark::State &state) {
+    auto n = static_cast<size_t>(state.range(0));
+    auto eng = engine(state.range(0));
+    auto ops = workload::trace(eng, workload::zipf<int>(eng, n, n), {0.7, 0.2, 0.1, 0, 0});
+    std::unique_ptr<Tree> tree;
+    for (auto _ : state) {
+        paused_reset(state, tree);
+        benchmark::DoNotOptimize(workload::replay(*tree, ops));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Heap>
+void heap_insertion(benchmark::State &state) {
+    auto keys = random_keys(state.range(0));
+    std::unique_ptr<Heap> heap;
+    for (auto _ : state) {
+        paused_reset(state, heap);
+        for (auto k : keys) heap->push(k);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class Heap>
+void heap_pop(benchmark::State &state) {
+    auto keys = random_keys(state.range(0));
+    std::unique_ptr<Heap> heap;
+    for (auto _ : state) {
+        state.PauseTiming();
+        heap = std::make_unique<Heap>();
+        for (auto k : keys) heap->push(k);
+        state.ResumeTiming();
+        while (!heap->empty()) {
+            benchmark::DoNotOptimize(heap->top());
+            heap->pop();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// as IntSetCheckingRunner: n keys out of the 16 bit universe, then every key of the universe is looked up
+template<class IntSet>
+void intset_checking(benchmark::State &state) {
+    IntSet set;
+    auto eng = engine(state.range(0));
+    auto keys = workload::permutation<unsigned short>(eng, 1u << 16);
+    keys.resize(state.range(0));
+    for (auto k : keys) set.insert(k);
+    for (auto _ : state) {
+        for (unsigned i = 0; i < (1u << 16); ++i)
+            benchmark::DoNotOptimize(workload::lookup(set, static_cast<unsigned short>(i)));
+    }
+    state.SetItemsProcessed(state.iterations() * (1u << 16));
+}
+
+template<class IntSet>
+void intset_insertion(benchmark::State &state) {
+    auto eng = engine(state.range(0));
+    auto keys = workload::permutation<unsigned short>(eng, 1u << 16);
+    keys.resize(state.range(0));
+    std::unique_ptr<IntSet> set;
+    for (auto _ : state) {
+        paused_reset(state, set);
+        for (auto k : keys) set->insert(k);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<class IntSet>
+void intset_successor(benchmark::State &state) {
+    IntSet set;
+    auto eng = engine(state.range(0));
+    auto keys = workload::permutation<unsigned short>(eng, 1u << 16);
+    keys.resize(state.range(0));
+    for (auto k : keys) set.insert(k);
+    for (auto _ : state) {
+        for (unsigned i = 0; i < (1u << 16); ++i)
+            benchmark::DoNotOptimize(workload::successor(set, static_cast<unsigned short>(i), 0));
+    }
+    state.SetItemsProcessed(state.iterations() * (1u << 16));
+}
+
+void tree_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(4)->Range(16, 1 << 14);
+}
+
+void heap_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(4)->Range(16, 1 << 16);
+}
+
+void intset_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(8)->Range(1, 1 << 12);
+}
+
+// `prefix` is the name the in-house suites give the container, e.g. RbTree for RbTreeRandomInsertion
+template<class Tree>
+void register_tree(const std::string &prefix) {
+    benchmark::RegisterBenchmark((prefix + "RandomInsertion").c_str(), random_insertion<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "OrderedInsertion").c_str(), ordered_insertion<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "RandomDeletion").c_str(), random_deletion<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "Checking").c_str(), checking<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "ZipfChecking").c_str(), zipf_checking<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "Iteration").c_str(), iteration<Tree>)->Apply(tree_sizes);
+    benchmark::RegisterBenchmark((prefix + "MixedTrace").c_str(), mixed_trace<Tree>)->Apply(tree_sizes);
+}
+
+template<class Heap>
+void register_heap(const std::string &prefix) {
+    benchmark::RegisterBenchmark((prefix + "Insertion").c_str(), heap_insertion<Heap>)->Apply(heap_sizes);
+    benchmark::RegisterBenchmark((prefix + "Pop").c_str(), heap_pop<Heap>)->Apply(heap_sizes);
+}
+
+template<class IntSet>
+void register_intset(const std::string &prefix) {
+    benchmark::RegisterBenchmark((prefix + "Checking").c_str(), intset_checking<IntSet>)->Apply(intset_sizes);
+    benchmark::RegisterBenchmark((prefix + "Insertion").c_str(), intset_insertion<IntSet>)->Apply(intset_sizes);
+    benchmark::RegisterBenchmark((prefix + "Successor").c_str(), intset_successor<IntSet>)->Apply(intset_sizes);
+}
+
+int main(int argc, char **argv) {
+    register_tree<AVLTree<int>>("AVLTree");
+    register_tree<RbTree<int>>("RbTree");
+    register_tree<Splay<int>>("SplayTree");
+    register_tree<Treap<int>>("TreapTree");
+    register_tree<ScapeGoat<int>>("ScapegoatTree");
+    register_tree<BPlusTree<int>>("BPlusTree");
+    register_tree<std::set<int>>("SetTree");
+
+    register_heap<BinaryHeap<int>>("BinaryHeap");
+    register_heap<DaryHeap<int, 4>>("4AryHeap");
+    register_heap<DaryHeap<int, 8>>("8AryHeap");
+    register_heap<FibHeap<int>>("FibHeap");
+    register_heap<BinomialHeap<int>>("BinomialHeap");
+    register_heap<PairingHeap<int>>("PairingHeap");
+    register_heap<IndexedBinaryHeap<int>>("IndexedBinaryHeap");
+    register_heap<MinMaxHeap<int>>("MinMaxHeap");
+    register_heap<std::priority_queue<int>>("PQ");
+
+    register_intset<std::set<unsigned short>>("STLIntSet");
+    register_intset<VebTree<unsigned short>>("VebTree");
+    register_intset<BinaryTrie<unsigned short>>("BinaryTrie");
+    register_intset<XFastTrie<unsigned short>>("XFastTrie");
+    register_intset<YFastTrie<unsigned short>>("YFastTrie");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
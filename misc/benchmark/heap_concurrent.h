@@ -0,0 +1,102 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_CONCURRENT_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_CONCURRENT_H
+
+#include "benchmark.h"
+#include <concurrent_skip_queue.hpp>
+#include <pairing_heap.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    // a sequential heap behind one lock, what a shared queue falls back to without a concurrent one
+    template<class Heap>
+    struct LockedHeap {
+        Heap heap;
+        std::mutex mutex;
+
+        explicit LockedHeap(size_t) {}
+
+        void push(int t) {
+            std::lock_guard<std::mutex> guard(mutex);
+            heap.push(t);
+        }
+
+        std::optional<int> pop() {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (heap.empty()) return std::nullopt;
+            int res = heap.top();
+            heap.pop();
+            return res;
+        }
+    };
+
+    template<bool relaxed>
+    struct SkipQueue {
+        ConcurrentSkipQueue<int> queue;
+
+        explicit SkipQueue(size_t threads) : queue(threads) {}
+
+        void push(int t) { queue.push(t); }
+
+        std::optional<int> pop() { return relaxed ? queue.try_pop_relaxed() : queue.try_pop(); }
+    };
+
+    /*
+     * Throughput of a queue shared by n threads: starting from `preload` keys, the threads perform `total`
+     * operations between them, each one a push of a random key or a pop with even odds, so the amount of work is
+     * the same whatever n is and the time should fall as n grows, up to the number of cores.
+     * Sizes are thread counts. The threads are started before the measured region and released together; the
+     * operations are not timed one by one, as the latency histogram is not thread safe.
+     */
+    template<class Queue>
+    struct ConcurrentHeapRunner : public BenchMark {
+        constexpr static size_t preload = 1u << 16u, total = 1u << 20u;
+
+        explicit ConcurrentHeapRunner(std::string name)
+                : BenchMark(std::move(name), 1, std::max(2u, std::thread::hardware_concurrency())) {}
+
+        size_t operations(size_t) override { return total; }
+
+        long long run(size_t n) override {
+            Queue queue(n);
+            std::vector<int> vec;
+            gen_random_int(vec, preload);
+            for (auto i : vec) queue.push(i);
+            std::atomic<bool> go{false};
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < n; ++t) {
+                threads.emplace_back([&, t, seed = rand()] {
+                    std::minstd_rand eng(seed);
+                    auto ops = total / n + (t < total % n);
+                    while (!go.load(std::memory_order_acquire));
+                    for (size_t i = 0; i < ops; ++i) {
+                        auto r = eng();
+                        if (r & 1u) queue.push(static_cast<int>(r >> 1u));
+                        else do_not_optimize(queue.pop());
+                    }
+                });
+            }
+            start();
+            go.store(true, std::memory_order_release);
+            for (auto &i : threads) i.join();
+            return stop();
+        }
+    };
+
+    ConcurrentHeapRunner<SkipQueue<false>> skip_queue_concurrent("ConcurrentSkipQueueConcurrent");
+    ConcurrentHeapRunner<SkipQueue<true>> skip_queue_relaxed_concurrent("ConcurrentSkipQueueRelaxedConcurrent");
+    ConcurrentHeapRunner<LockedHeap<PairingHeap<int>>> locked_pairing_heap_concurrent("LockedPairingHeapConcurrent");
+    ConcurrentHeapRunner<LockedHeap<std::priority_queue<int, std::vector<int>, std::greater<>>>>
+            locked_pq_concurrent("LockedPQConcurrent");
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_CONCURRENT_H
@@ -10,58 +10,71 @@
 #include <binomial_heap.hpp>
 #include <fib_heap.hpp>
 #include <pairing_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <algorithm>
 
 
 namespace benchmark {
     using namespace data_structure;
-#ifndef HEAP_RUNNER
-#define HEAP_RUNNER
 
-    struct HeapRunner : public BenchMark {
-        std::string name;
+    template<class Heap>
+    struct HeapDecreasingRunner : public BenchMark {
 
-        explicit HeapRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
 
-#endif
+        explicit HeapDecreasingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
+        long long run(size_t n) override {
+            Heap heap;
+            std::vector<int> vec;
+            std::vector<typename Heap::handle> handles;
+            gen_random_int(vec, n);
+            handles.reserve(vec.size());
+            for (auto i : vec) {
+                handles.push_back(heap.push(i));
+            }
+            start();
+            for (auto h : handles) {
+                timed([&] {
+                    auto v = heap.get(h);
+                    heap.decrease_key(h, v - rand() % (v / 2 + 1));
+                });
+            }
+            return stop();
+        }
+    };
 
+    // every element is erased through its handle, in random order
     template<class Heap>
-    struct HeapDecreasingRunner : public HeapRunner {
+    struct HeapErasingRunner : public BenchMark {
 
 
-        explicit HeapDecreasingRunner(std::string name) noexcept : HeapRunner(std::move(name)) {}
+        explicit HeapErasingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Heap heap;
             std::vector<int> vec;
-            std::vector<typename Heap::value_holder> holders;
+            std::vector<typename Heap::handle> handles;
             gen_random_int(vec, n);
-            holders.reserve(vec.size());
+            handles.reserve(vec.size());
             for (auto i : vec) {
-                holders.push_back(heap.push_and_hold(i));
+                handles.push_back(heap.push(i));
             }
-            auto a = time_now();
-            for (auto i : holders) {
-                i.re_push(i.get() - rand() % i.get());
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+            std::random_shuffle(handles.begin(), handles.end());
+            start();
+            for (auto h : handles) {
+                timed([&] { heap.erase(h); });
             }
-            return result;
+            return stop();
         }
     };
 
     HeapDecreasingRunner<FibHeap<int>> fib_heap_dec("FibHeapDecreasing");
     HeapDecreasingRunner<BinomialHeap<int>> binomial_heap_dec("BinomialHeapDecreasing");
     HeapDecreasingRunner<PairingHeap<int>> pairing_heap_dec("PairingHeapDecreasing");
+    HeapDecreasingRunner<IndexedBinaryHeap<int>> indexed_binary_heap_dec("IndexedBinaryHeapDecreasing");
+    HeapErasingRunner<FibHeap<int>> fib_heap_erase("FibHeapErasing");
+    HeapErasingRunner<BinomialHeap<int>> binomial_heap_erase("BinomialHeapErasing");
+    HeapErasingRunner<PairingHeap<int>> pairing_heap_erase("PairingHeapErasing");
+    HeapErasingRunner<IndexedBinaryHeap<int>> indexed_binary_heap_erase("IndexedBinaryHeapErasing");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_HEAP_DECREASING_H
@@ -0,0 +1,144 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_DIJKSTRA_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_DIJKSTRA_H
+
+#include "benchmark.h"
+#include "heap_monotone.h"
+#include <binary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <dary_heap.hpp>
+#include <fib_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <min_max_heap.hpp>
+#include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
+#include <radix_heap.hpp>
+#include <limits>
+#include <vector>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    // adjacency lists in one array: the edges of v are edges[first[v]] ... edges[first[v + 1] - 1]
+    struct Graph {
+        struct Edge {
+            unsigned to, weight;
+        };
+        std::vector<size_t> first;
+        std::vector<Edge> edges;
+
+        size_t vertices() const noexcept { return first.size() - 1; }
+    };
+
+    /*
+     * Single source shortest paths from vertex 0 on a graph of n vertices: v -> v + 1 keeps every vertex
+     * reachable, and each vertex gets `degree(n)` more edges to random vertices. Weights are in [1, 1024].
+     * With `Decrease`, a reached vertex stays in the heap once and improves through decrease_key; otherwise a
+     * vertex is pushed again whenever its distance improves and the stale entries are skipped when popped.
+     * Operations are edges, every one of them being relaxed once.
+     */
+    template<class Heap, bool Decrease = false>
+    struct DijkstraRunner : public BenchMark {
+        size_t (*degree)(size_t);
+
+        DijkstraRunner(std::string name, size_t (*degree)(size_t), size_t last) noexcept
+                : BenchMark(std::move(name), 1, last), degree(degree) {}
+
+        size_t operations(size_t n) override { return n * (degree(n) + 1); }
+
+        Graph generate(size_t n) {
+            Graph graph;
+            graph.first.reserve(n + 1);
+            graph.edges.reserve(operations(n));
+            for (size_t v = 0; v < n; ++v) {
+                graph.first.push_back(graph.edges.size());
+                graph.edges.push_back({static_cast<unsigned>((v + 1) % n), 1 + static_cast<unsigned>(rand() % 1024)});
+                for (size_t i = degree(n); i; --i) {
+                    graph.edges.push_back({static_cast<unsigned>(rand() % n), 1 + static_cast<unsigned>(rand() % 1024)});
+                }
+            }
+            graph.first.push_back(graph.edges.size());
+            return graph;
+        }
+
+        static void lazy(const Graph &graph, std::vector<unsigned> &dist) {
+            Heap heap;
+            dist[0] = 0;
+            heap.push(MonotoneEntry(0, 0));
+            while (!heap.empty()) {
+                auto [d, v] = heap.top();
+                heap.pop();
+                if (d > dist[v]) continue;
+                for (auto e = graph.first[v]; e < graph.first[v + 1]; ++e) {
+                    auto &edge = graph.edges[e];
+                    if (d + edge.weight < dist[edge.to]) {
+                        dist[edge.to] = d + edge.weight;
+                        heap.push(MonotoneEntry(dist[edge.to], edge.to));
+                    }
+                }
+            }
+        }
+
+        static void decrease(const Graph &graph, std::vector<unsigned> &dist) {
+            Heap heap;
+            std::vector<typename Heap::handle> handles(graph.vertices());
+            std::vector<bool> done(graph.vertices());
+            dist[0] = 0;
+            handles[0] = heap.push(MonotoneEntry(0, 0));
+            while (!heap.empty()) {
+                auto [d, v] = heap.top();
+                heap.pop();
+                done[v] = true;
+                for (auto e = graph.first[v]; e < graph.first[v + 1]; ++e) {
+                    auto &edge = graph.edges[e];
+                    if (done[edge.to] || d + edge.weight >= dist[edge.to]) continue;
+                    auto reached = dist[edge.to] != std::numeric_limits<unsigned>::max();
+                    dist[edge.to] = d + edge.weight;
+                    if (reached) heap.decrease_key(handles[edge.to], MonotoneEntry(dist[edge.to], edge.to));
+                    else handles[edge.to] = heap.push(MonotoneEntry(dist[edge.to], edge.to));
+                }
+            }
+        }
+
+        long long run(size_t n) override {
+            auto graph = generate(n);
+            std::vector<unsigned> dist(n, std::numeric_limits<unsigned>::max());
+            start();
+            if constexpr (Decrease) decrease(graph, dist);
+            else lazy(graph, dist);
+            auto res = stop();
+            do_not_optimize(dist.back());
+            return res;
+        }
+    };
+
+    inline size_t sparse_degree(size_t) { return 4; }
+
+    // a quarter of all possible edges
+    inline size_t dense_degree(size_t n) { return n / 4; }
+
+    template<class Heap, bool Decrease = false>
+    struct DijkstraSuite {
+        DijkstraRunner<Heap, Decrease> sparse, dense;
+
+        explicit DijkstraSuite(const std::string &name)
+                : sparse(name + "DijkstraSparse", sparse_degree, 10000),
+                  dense(name + "DijkstraDense", dense_degree, 1000) {}
+    };
+
+    DijkstraSuite<BinaryHeap<MonotoneEntry>> binary_heap_dijkstra("BinaryHeap");
+    DijkstraSuite<DaryHeap<MonotoneEntry, 4>> quaternary_heap_dijkstra("4AryHeap");
+    DijkstraSuite<DaryHeap<MonotoneEntry, 8>> octonary_heap_dijkstra("8AryHeap");
+    DijkstraSuite<MinMaxHeap<MonotoneEntry>> min_max_heap_dijkstra("MinMaxHeap");
+    DijkstraSuite<RadixHeap<unsigned, unsigned>> radix_heap_dijkstra("RadixHeap");
+    DijkstraSuite<PersistentLeftistHeap<MonotoneEntry>> persistent_leftist_heap_dijkstra("PersistentLeftistHeap");
+    DijkstraSuite<MonotonePQ> pq_dijkstra("PQ");
+    DijkstraSuite<IndexedBinaryHeap<MonotoneEntry>, true> indexed_binary_heap_dijkstra("IndexedBinaryHeap");
+    DijkstraSuite<FibHeap<MonotoneEntry>, true> fib_heap_dijkstra("FibHeap");
+    DijkstraSuite<BinomialHeap<MonotoneEntry>, true> binomial_heap_dijkstra("BinomialHeap");
+    DijkstraSuite<PairingHeap<MonotoneEntry>, true> pairing_heap_dijkstra("PairingHeap");
+    // the pairing heap with lazy deletion, as its decrease_key scans the sibling list
+    DijkstraSuite<PairingHeap<MonotoneEntry>> pairing_heap_lazy_dijkstra("PairingHeapLazy");
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_DIJKSTRA_H
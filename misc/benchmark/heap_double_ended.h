@@ -0,0 +1,171 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_DOUBLE_ENDED_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_DOUBLE_ENDED_H
+
+#include "benchmark.h"
+#include <binary_heap.hpp>
+#include <min_max_heap.hpp>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * A double ended queue made of a min BinaryHeap and a max BinaryHeap holding the same elements, tagged with an
+     * id. Popping from one end only marks the id removed; the copy in the other heap is dropped lazily once it
+     * reaches that heap's top.
+     */
+    class MirroredBinaryHeaps {
+        using Entry = std::pair<int, size_t>;
+
+        BinaryHeap<Entry, std::less<>> min;
+        BinaryHeap<Entry, std::greater<>> max;
+        std::vector<bool> removed;
+        size_t n = 0;
+
+        template<class Heap>
+        void clean(Heap &heap) {
+            while (removed[heap.top().second]) heap.pop();
+        }
+
+        template<class Heap>
+        void pop_from(Heap &heap) {
+            clean(heap);
+            removed[heap.top().second] = true;
+            heap.pop();
+            --n;
+        }
+
+    public:
+        MirroredBinaryHeaps() = default;
+
+        template<typename InputIt>
+        MirroredBinaryHeaps(InputIt first, InputIt last) {
+            std::vector<Entry> entries;
+            for (; first != last; ++first) entries.emplace_back(*first, entries.size());
+            removed.resize(entries.size());
+            n = entries.size();
+            min = decltype(min)(entries.begin(), entries.end());
+            max = decltype(max)(entries.begin(), entries.end());
+        }
+
+        void push(int t) {
+            Entry entry(t, removed.size());
+            removed.push_back(false);
+            min.push(entry);
+            max.push(entry);
+            ++n;
+        }
+
+        int top_min() {
+            clean(min);
+            return min.top().first;
+        }
+
+        int top_max() {
+            clean(max);
+            return max.top().first;
+        }
+
+        void pop_min() { pop_from(min); }
+
+        void pop_max() { pop_from(max); }
+
+        size_t size() const { return n; }
+    };
+
+    struct MultisetDEPQ {
+        std::multiset<int> set;
+
+        MultisetDEPQ() = default;
+
+        template<typename InputIt>
+        MultisetDEPQ(InputIt first, InputIt last) : set(first, last) {}
+
+        void push(int t) { set.insert(t); }
+
+        int top_min() { return *set.begin(); }
+
+        int top_max() { return *set.rbegin(); }
+
+        void pop_min() { set.erase(set.begin()); }
+
+        void pop_max() { set.erase(std::prev(set.end())); }
+    };
+
+    /*
+     * Admission control: with n requests queued, take the cheapest or the most expensive one at random and queue a
+     * new request in its place, n times.
+     */
+    template<class Queue>
+    struct DoubleEndedHoldRunner : public BenchMark {
+
+        explicit DoubleEndedHoldRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
+            Queue queue;
+            std::vector<int> vec;
+            gen_random_int(vec, 2 * n);
+            for (size_t i = 0; i < n; ++i) queue.push(vec[i]);
+            start();
+            for (size_t i = n; i < 2 * n; ++i) {
+                timed([&] {
+                    if (vec[i] & 1) {
+                        do_not_optimize(queue.top_max());
+                        queue.pop_max();
+                    } else {
+                        do_not_optimize(queue.top_min());
+                        queue.pop_min();
+                    }
+                });
+                timed([&] { queue.push(vec[i]); });
+            }
+            return stop();
+        }
+    };
+
+    /*
+     * Build from a range of n keys, then drain it from both ends alternately.
+     */
+    template<class Queue>
+    struct DoubleEndedBuildRunner : public BenchMark {
+
+        explicit DoubleEndedBuildRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
+            std::vector<int> vec;
+            gen_random_int(vec, n);
+            start();
+            Queue queue(vec.begin(), vec.end());
+            for (size_t i = 0; i < n; ++i) {
+                timed([&] {
+                    if (i & 1u) {
+                        do_not_optimize(queue.top_max());
+                        queue.pop_max();
+                    } else {
+                        do_not_optimize(queue.top_min());
+                        queue.pop_min();
+                    }
+                });
+            }
+            return stop();
+        }
+    };
+
+    DoubleEndedHoldRunner<MinMaxHeap<int>> min_max_heap_double_ended_hold("MinMaxHeapDoubleEndedHold");
+    DoubleEndedHoldRunner<MirroredBinaryHeaps> mirrored_heaps_double_ended_hold("MirroredBinaryHeapsDoubleEndedHold");
+    DoubleEndedHoldRunner<MultisetDEPQ> multiset_double_ended_hold("MultisetDoubleEndedHold");
+
+    DoubleEndedBuildRunner<MinMaxHeap<int>> min_max_heap_double_ended_build("MinMaxHeapDoubleEndedBuild");
+    DoubleEndedBuildRunner<MirroredBinaryHeaps> mirrored_heaps_double_ended_build("MirroredBinaryHeapsDoubleEndedBuild");
+    DoubleEndedBuildRunner<MultisetDEPQ> multiset_double_ended_build("MultisetDoubleEndedBuild");
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_DOUBLE_ENDED_H
@@ -0,0 +1,61 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_FORK_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_FORK_H
+
+#include "benchmark.h"
+#include <binary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
+#include <queue>
+#include <vector>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * Branch and bound: a pool of open subproblems, each with its own heap of n pending bounds. Every step forks a
+     * random subproblem by copying its heap, takes the best bound off the copy and pushes two refined ones, then
+     * puts the copy into the pool in place of a random subproblem. A persistent heap forks in O(1) and shares all
+     * nodes it does not touch; the other heaps copy all of theirs.
+     */
+    template<class Heap>
+    struct HeapForkRunner : public BenchMark {
+        constexpr static size_t pool = 8, forks = 64;
+
+        explicit HeapForkRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 2000) {}
+
+        size_t operations(size_t) override { return forks; }
+
+        long long run(size_t n) override {
+            std::vector<int> vec;
+            gen_random_int(vec, n + 3 * forks);
+            std::vector<Heap> open(pool);
+            for (size_t i = 0; i < n; ++i) open[0].push(vec[i] & 0xfffffff);
+            for (size_t i = 1; i < pool; ++i) open[i] = open[0];
+            start();
+            for (size_t i = 0; i < forks; ++i) {
+                auto r = static_cast<unsigned>(vec[n + 3 * i]);
+                timed([&] {
+                    Heap child = open[r % pool];
+                    if (!child.empty()) {
+                        auto bound = child.top();
+                        child.pop();
+                        child.push(bound + (vec[n + 3 * i + 1] & 1023));
+                        child.push(bound + (vec[n + 3 * i + 2] & 1023));
+                    }
+                    open[(r >> 8u) % pool] = std::move(child);
+                });
+            }
+            return stop();
+        }
+    };
+
+    HeapForkRunner<PersistentLeftistHeap<int>> persistent_leftist_heap_fork("PersistentLeftistHeapFork");
+    HeapForkRunner<BinaryHeap<int>> binary_heap_fork("BinaryHeapFork");
+    HeapForkRunner<BinomialHeap<int>> binomial_heap_fork("BinomialHeapFork");
+    HeapForkRunner<PairingHeap<int>> pairing_heap_fork("PairingHeapFork");
+    HeapForkRunner<std::priority_queue<int>> pq_fork("PQFork");
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_FORK_H
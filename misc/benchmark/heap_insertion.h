@@ -7,59 +7,74 @@
 
 #include "benchmark.h"
 #include <binary_heap.hpp>
+#include <dary_heap.hpp>
 #include <binomial_heap.hpp>
 #include <fib_heap.hpp>
 #include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <memory>
 #include <queue>
 
 
 namespace benchmark {
     using namespace data_structure;
-#ifndef HEAP_RUNNER
-#define HEAP_RUNNER
-
-    struct HeapRunner : public BenchMark {
-        std::string name;
-
-        explicit HeapRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
 
     template<class Heap>
-    struct HeapInsertionRunner : public HeapRunner {
+    struct HeapInsertionRunner : public BenchMark {
 
 
-        explicit HeapInsertionRunner(std::string name) noexcept : HeapRunner(std::move(name)) {}
+        explicit HeapInsertionRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Heap heap;
             std::vector<int> vec;
             gen_random_int(vec, n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                heap.push(i);
+                timed([&] { heap.push(i); });
             }
-            auto b = time_now();
-            return (b - a).count();
+            return stop();
         }
+    };
 
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+    /*
+     * Startup: load n keys in one call to the range constructor and pop the first element, so that the work a heap
+     * defers to its first pop (fib heap consolidation, pairing of the root's children) is paid in the measurement.
+     */
+    template<class Heap>
+    struct HeapBuildRunner : public BenchMark {
+
+
+        explicit HeapBuildRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        long long run(size_t n) override {
+            std::unique_ptr<Heap> heap;
+            std::vector<int> vec;
+            gen_random_int(vec, n);
+            start();
+            heap = std::make_unique<Heap>(vec.begin(), vec.end());
+            heap->pop();
+            return stop();
         }
     };
 
     HeapInsertionRunner<BinaryHeap<int>> binary_heap_insertion("BinaryHeapInsertion");
+    HeapInsertionRunner<DaryHeap<int, 4>> quaternary_heap_insertion("4AryHeapInsertion");
+    HeapInsertionRunner<DaryHeap<int, 8>> octonary_heap_insertion("8AryHeapInsertion");
     HeapInsertionRunner<FibHeap<int>> fib_heap_insertion("FibHeapInsertion");
     HeapInsertionRunner<BinomialHeap<int>> binomial_heap_insertion("BinomialHeapInsertion");
     HeapInsertionRunner<PairingHeap<int>> pairing_heap_insertion("PairingHeapInsertion");
+    HeapInsertionRunner<PersistentLeftistHeap<int>> persistent_leftist_heap_insertion("PersistentLeftistHeapInsertion");
     HeapInsertionRunner<std::priority_queue<int>> priority_queue_insertion("PQInsertion");
+
+    HeapBuildRunner<BinaryHeap<int>> binary_heap_build("BinaryHeapBuild");
+    HeapBuildRunner<DaryHeap<int, 4>> quaternary_heap_build("4AryHeapBuild");
+    HeapBuildRunner<DaryHeap<int, 8>> octonary_heap_build("8AryHeapBuild");
+    HeapBuildRunner<IndexedBinaryHeap<int>> indexed_binary_heap_build("IndexedBinaryHeapBuild");
+    HeapBuildRunner<FibHeap<int>> fib_heap_build("FibHeapBuild");
+    HeapBuildRunner<BinomialHeap<int>> binomial_heap_build("BinomialHeapBuild");
+    HeapBuildRunner<PairingHeap<int>> pairing_heap_build("PairingHeapBuild");
+    HeapBuildRunner<std::priority_queue<int>> priority_queue_build("PQBuild");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_HEAP_INSERTION_H
@@ -9,30 +9,27 @@
 #include <binary_heap.hpp>
 #include <binomial_heap.hpp>
 #include <fib_heap.hpp>
+#include <dary_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <min_max_heap.hpp>
 #include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
+#include <queue>
+#include <vector>
 
 
 namespace benchmark {
     using namespace data_structure;
-#ifndef HEAP_RUNNER
-#define HEAP_RUNNER
-
-    struct HeapRunner : public BenchMark {
-        std::string name;
-
-        explicit HeapRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
 
     template<class Heap>
-    struct HeapMeldingRunner : public HeapRunner {
+    struct HeapMeldingRunner : public BenchMark {
 
 
-        explicit HeapMeldingRunner(std::string name) noexcept : HeapRunner(std::move(name)) {}
+        explicit HeapMeldingRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        size_t operations(size_t n) override { return 1; }
+
+        long long run(size_t n) override {
             Heap heap0, heap1;
             std::vector<int> vec0;
             std::vector<int> vec1;
@@ -44,25 +41,71 @@ namespace benchmark {
             for (auto i : vec0) {
                 heap1.push(i);
             }
-            auto a = time_now();
+            start();
             heap0.merge(heap1);
-            auto b = time_now();
-            return (b - a).count();
+            return stop();
+        }
+    };
+
+    // heaps without merge take the elements of the other heap one by one
+    template<class Heap>
+    auto meld(Heap &heap, Heap &that, int) -> decltype(heap.merge(that), void()) {
+        heap.merge(that);
+    }
+
+    template<class Heap>
+    void meld(Heap &heap, Heap &that, long) {
+        while (!that.empty()) {
+            heap.push(that.top());
+            that.pop();
         }
+    }
+
+    /*
+     * Knockout tournament: n keys are dealt into heaps of 8, then the heaps are melded pairwise in rounds until one is
+     * left; after every meld the winner gives up its top element. Operations are the melds and the pops.
+     */
+    template<class Heap>
+    struct HeapTournamentRunner : public BenchMark {
+        constexpr static size_t team = 8;
 
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+        explicit HeapTournamentRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override {
+            auto heaps = (n + team - 1) / team;
+            return heaps ? 2 * (heaps - 1) : 0;
+        }
+
+        long long run(size_t n) override {
+            std::vector<int> vec;
+            gen_random_int(vec, n);
+            start();
+            std::vector<Heap> heaps((n + team - 1) / team);
+            for (size_t i = 0; i < n; ++i) heaps[i / team].push(vec[i]);
+            // the winners stay in place, so heaps that cannot be moved take part as well
+            for (size_t stride = 1; stride < heaps.size(); stride *= 2) {
+                for (size_t i = 0; i + stride < heaps.size(); i += 2 * stride) {
+                    timed([&] { meld(heaps[i], heaps[i + stride], 0); });
+                    timed([&] { heaps[i].pop(); });
+                }
             }
-            return result;
+            return stop();
         }
     };
 
     HeapMeldingRunner<FibHeap<int>> fib_heap_meld("FibHeapMelding");
     HeapMeldingRunner<BinomialHeap<int>> binomial_heap_meld("BinomialHeapMelding");
     HeapMeldingRunner<PairingHeap<int>> pairing_heap_meld("PairingHeapMelding");
+    HeapMeldingRunner<PersistentLeftistHeap<int>> persistent_leftist_heap_meld("PersistentLeftistHeapMelding");
+
+    HeapTournamentRunner<BinaryHeap<int>> binary_heap_tournament("BinaryHeapTournament");
+    HeapTournamentRunner<DaryHeap<int, 4>> quaternary_heap_tournament("4AryHeapTournament");
+    HeapTournamentRunner<MinMaxHeap<int>> min_max_heap_tournament("MinMaxHeapTournament");
+    HeapTournamentRunner<IndexedBinaryHeap<int>> indexed_binary_heap_tournament("IndexedBinaryHeapTournament");
+    HeapTournamentRunner<FibHeap<int>> fib_heap_tournament("FibHeapTournament");
+    HeapTournamentRunner<BinomialHeap<int>> binomial_heap_tournament("BinomialHeapTournament");
+    HeapTournamentRunner<PairingHeap<int>> pairing_heap_tournament("PairingHeapTournament");
+    HeapTournamentRunner<PersistentLeftistHeap<int>> persistent_leftist_heap_tournament("PersistentLeftistHeapTournament");
+    HeapTournamentRunner<std::priority_queue<int>> pq_tournament("PQTournament");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_HEAP_MELDING_H
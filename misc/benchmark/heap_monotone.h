@@ -0,0 +1,106 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_MONOTONE_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_MONOTONE_H
+
+#include "benchmark.h"
+#include <binary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <dary_heap.hpp>
+#include <fib_heap.hpp>
+#include <indexed_binary_heap.hpp>
+#include <min_max_heap.hpp>
+#include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
+#include <radix_heap.hpp>
+#include <queue>
+#include <utility>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    // a key and the payload it carries, e.g. a distance and a vertex
+    using MonotoneEntry = std::pair<unsigned, unsigned>;
+
+    /*
+     * Hold model of an event simulation: with n events pending, pop the earliest one and schedule a new event at
+     * a random delay after it, n times. The popped keys never decrease, which is all a radix heap needs.
+     */
+    template<class Heap>
+    struct HeapHoldRunner : public BenchMark {
+
+
+        explicit HeapHoldRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
+            Heap heap;
+            std::vector<int> vec;
+            gen_random_int(vec, 2 * n);
+            for (size_t i = 0; i < n; ++i) heap.push(MonotoneEntry(vec[i] & 0xfffffu, i));
+            start();
+            for (size_t i = n; i < 2 * n; ++i) {
+                unsigned now = 0;
+                timed([&] {
+                    now = heap.top().first;
+                    heap.pop();
+                });
+                timed([&] { heap.push(MonotoneEntry(now + (vec[i] & 0xfffffu), i)); });
+            }
+            return stop();
+        }
+    };
+
+    /*
+     * Drain: push n keys, then pop them all; the first pop of a radix heap redistributes every element.
+     */
+    template<class Heap>
+    struct HeapDrainRunner : public BenchMark {
+
+
+        explicit HeapDrainRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
+
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
+            Heap heap;
+            std::vector<int> vec;
+            gen_random_int(vec, n);
+            start();
+            for (size_t i = 0; i < n; ++i) {
+                timed([&] { heap.push(MonotoneEntry(vec[i], i)); });
+            }
+            while (!heap.empty()) {
+                timed([&] { heap.pop(); });
+            }
+            return stop();
+        }
+    };
+
+    using MonotonePQ = std::priority_queue<MonotoneEntry, std::vector<MonotoneEntry>, std::greater<>>;
+
+    HeapHoldRunner<RadixHeap<unsigned, unsigned>> radix_heap_hold("RadixHeapHold");
+    HeapHoldRunner<BinaryHeap<MonotoneEntry>> binary_heap_hold("BinaryHeapHold");
+    HeapHoldRunner<DaryHeap<MonotoneEntry, 4>> quaternary_heap_hold("4AryHeapHold");
+    HeapHoldRunner<DaryHeap<MonotoneEntry, 8>> octonary_heap_hold("8AryHeapHold");
+    HeapHoldRunner<MinMaxHeap<MonotoneEntry>> min_max_heap_hold("MinMaxHeapHold");
+    HeapHoldRunner<IndexedBinaryHeap<MonotoneEntry>> indexed_binary_heap_hold("IndexedBinaryHeapHold");
+    HeapHoldRunner<FibHeap<MonotoneEntry>> fib_heap_hold("FibHeapHold");
+    HeapHoldRunner<BinomialHeap<MonotoneEntry>> binomial_heap_hold("BinomialHeapHold");
+    HeapHoldRunner<PairingHeap<MonotoneEntry>> pairing_heap_hold("PairingHeapHold");
+    HeapHoldRunner<PersistentLeftistHeap<MonotoneEntry>> persistent_leftist_heap_hold("PersistentLeftistHeapHold");
+    HeapHoldRunner<MonotonePQ> pq_hold("PQHold");
+
+    HeapDrainRunner<RadixHeap<unsigned, unsigned>> radix_heap_drain("RadixHeapDrain");
+    HeapDrainRunner<BinaryHeap<MonotoneEntry>> binary_heap_drain("BinaryHeapDrain");
+    HeapDrainRunner<DaryHeap<MonotoneEntry, 4>> quaternary_heap_drain("4AryHeapDrain");
+    HeapDrainRunner<DaryHeap<MonotoneEntry, 8>> octonary_heap_drain("8AryHeapDrain");
+    HeapDrainRunner<MinMaxHeap<MonotoneEntry>> min_max_heap_drain("MinMaxHeapDrain");
+    HeapDrainRunner<IndexedBinaryHeap<MonotoneEntry>> indexed_binary_heap_drain("IndexedBinaryHeapDrain");
+    HeapDrainRunner<FibHeap<MonotoneEntry>> fib_heap_drain("FibHeapDrain");
+    HeapDrainRunner<BinomialHeap<MonotoneEntry>> binomial_heap_drain("BinomialHeapDrain");
+    HeapDrainRunner<PairingHeap<MonotoneEntry>> pairing_heap_drain("PairingHeapDrain");
+    HeapDrainRunner<PersistentLeftistHeap<MonotoneEntry>> persistent_leftist_heap_drain("PersistentLeftistHeapDrain");
+    HeapDrainRunner<MonotonePQ> pq_drain("PQDrain");
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_MONOTONE_H
@@ -7,62 +7,45 @@
 
 #include "benchmark.h"
 #include <binary_heap.hpp>
+#include <dary_heap.hpp>
 #include <binomial_heap.hpp>
 #include <fib_heap.hpp>
 #include <pairing_heap.hpp>
+#include <persistent_leftist_heap.hpp>
 #include <queue>
 
 
 namespace benchmark {
     using namespace data_structure;
-#ifndef HEAP_RUNNER
-#define HEAP_RUNNER
-
-    struct HeapRunner : public BenchMark {
-        std::string name;
-
-        explicit HeapRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
 
     template<class Heap>
-    struct HeapPopRunner : public HeapRunner {
+    struct HeapPopRunner : public BenchMark {
 
 
-        explicit HeapPopRunner(std::string name) noexcept : HeapRunner(std::move(name)) {}
+        explicit HeapPopRunner(std::string name) noexcept : BenchMark(std::move(name)) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             Heap heap;
             std::vector<int> vec;
             gen_random_int(vec, n);
             for (auto i : vec) {
                 heap.push(i);
             }
-            auto a = time_now();
+            start();
             while (!heap.empty()) {
-                heap.pop();
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 10000; ++i) {
-                auto t = run(i);
-                result.outcomes.emplace_back(i, t);
+                timed([&] { heap.pop(); });
             }
-            return result;
+            return stop();
         }
     };
 
     HeapPopRunner<BinaryHeap<int>> binary_heap_pop("BinaryHeapPop");
+    HeapPopRunner<DaryHeap<int, 4>> quaternary_heap_pop("4AryHeapPop");
+    HeapPopRunner<DaryHeap<int, 8>> octonary_heap_pop("8AryHeapPop");
     HeapPopRunner<FibHeap<int>> fib_heap_pop("FibHeapPop");
     HeapPopRunner<BinomialHeap<int>> binomial_heap_pop("BinomialHeapPop");
     HeapPopRunner<PairingHeap<int>> pairing_heap_pop("PairingHeapPop");
+    HeapPopRunner<PersistentLeftistHeap<int>> persistent_leftist_heap_pop("PersistentLeftistHeapPop");
     HeapPopRunner<std::priority_queue<int>> pq_pop("PQPop");
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_HEAP_POP_H
@@ -0,0 +1,119 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HEAP_WORKLOAD_H
+#define DATA_STRUCTURE_FOR_LOVE_HEAP_WORKLOAD_H
+
+#include "benchmark.h"
+#include "workload.h"
+#include <binary_heap.hpp>
+#include <binomial_heap.hpp>
+#include <fib_heap.hpp>
+#include <pairing_heap.hpp>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <queue>
+
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * Push n keys of a shaped sequence and pop them all again.
+     */
+    template<class Heap>
+    struct HeapPatternRunner : public BenchMark {
+        std::function<std::vector<int>(workload::Engine &, size_t)> pattern;
+
+        HeapPatternRunner(std::string name, std::function<std::vector<int>(workload::Engine &, size_t)> pattern)
+                : BenchMark(std::move(name)), pattern(std::move(pattern)) {}
+
+        size_t operations(size_t n) override { return 2 * n; }
+
+        long long run(size_t n) override {
+            Heap heap;
+            auto vec = pattern(rand.eng, n);
+            start();
+            for (auto i : vec) {
+                timed([&] { heap.push(i); });
+            }
+            while (!heap.empty()) {
+                timed([&] { heap.pop(); });
+            }
+            return stop();
+        }
+    };
+
+    /*
+     * Push n keys of a shaped sequence, then time destroying the heap. The nodes come from new/delete, so that
+     * the whole forest has to be walked (a pool of ints is released without a walk).
+     */
+    template<class Heap>
+    struct HeapTeardownRunner : public BenchMark {
+        std::function<std::vector<int>(workload::Engine &, size_t)> pattern;
+
+        HeapTeardownRunner(std::string name, std::function<std::vector<int>(workload::Engine &, size_t)> pattern)
+                : BenchMark(std::move(name)), pattern(std::move(pattern)) {}
+
+        long long run(size_t n) override {
+            auto heap = std::make_unique<Heap>();
+            auto vec = pattern(rand.eng, n);
+            for (auto i : vec) heap->push(i);
+            // a few pops give the fib and pairing heaps their trees
+            for (auto i = 0; i < 4 && !heap->empty(); ++i) heap->pop();
+            start();
+            heap.reset();
+            return stop();
+        }
+    };
+
+    inline std::vector<int> heap_sawtooth_pattern(workload::Engine &, size_t n) {
+        return workload::sawtooth(n);
+    }
+
+    inline std::vector<int> heap_adversarial_pattern(workload::Engine &, size_t n) {
+        return workload::adversarial(n);
+    }
+
+    inline std::vector<int> heap_zipf_pattern(workload::Engine &eng, size_t n) {
+        return workload::zipf(eng, n, n);
+    }
+
+    inline std::vector<int> heap_uniform_pattern(workload::Engine &eng, size_t n) {
+        return workload::uniform<int>(eng, n, INT_MAX);
+    }
+
+    // n, n - 1, ..., 1: every push becomes the new root of a pairing heap, which degenerates into a path
+    inline std::vector<int> heap_descending_pattern(workload::Engine &, size_t n) {
+        std::vector<int> res(n);
+        for (size_t i = 0; i < n; ++i) res[i] = static_cast<int>(n - i);
+        return res;
+    }
+
+    HeapPatternRunner<BinaryHeap<int>> binary_heap_sawtooth("BinaryHeapSawtooth", heap_sawtooth_pattern);
+    HeapPatternRunner<FibHeap<int>> fib_heap_sawtooth("FibHeapSawtooth", heap_sawtooth_pattern);
+    HeapPatternRunner<BinomialHeap<int>> binomial_heap_sawtooth("BinomialHeapSawtooth", heap_sawtooth_pattern);
+    HeapPatternRunner<PairingHeap<int>> pairing_heap_sawtooth("PairingHeapSawtooth", heap_sawtooth_pattern);
+    HeapPatternRunner<std::priority_queue<int>> pq_sawtooth("PQSawtooth", heap_sawtooth_pattern);
+
+    HeapPatternRunner<BinaryHeap<int>> binary_heap_adversarial("BinaryHeapAdversarial", heap_adversarial_pattern);
+    HeapPatternRunner<FibHeap<int>> fib_heap_adversarial("FibHeapAdversarial", heap_adversarial_pattern);
+    HeapPatternRunner<BinomialHeap<int>> binomial_heap_adversarial("BinomialHeapAdversarial", heap_adversarial_pattern);
+    HeapPatternRunner<PairingHeap<int>> pairing_heap_adversarial("PairingHeapAdversarial", heap_adversarial_pattern);
+    HeapPatternRunner<std::priority_queue<int>> pq_adversarial("PQAdversarial", heap_adversarial_pattern);
+
+    // heavy key duplication
+    HeapPatternRunner<BinaryHeap<int>> binary_heap_zipf("BinaryHeapZipf", heap_zipf_pattern);
+    HeapPatternRunner<FibHeap<int>> fib_heap_zipf("FibHeapZipf", heap_zipf_pattern);
+    HeapPatternRunner<BinomialHeap<int>> binomial_heap_zipf("BinomialHeapZipf", heap_zipf_pattern);
+    HeapPatternRunner<PairingHeap<int>> pairing_heap_zipf("PairingHeapZipf", heap_zipf_pattern);
+    HeapPatternRunner<std::priority_queue<int>> pq_zipf("PQZipf", heap_zipf_pattern);
+
+    HeapTeardownRunner<FibHeap<int, std::less<int>, utils::TrivialFactory<FibHeapNode<int>>>>
+            fib_heap_teardown("FibHeapTeardown", heap_uniform_pattern);
+    HeapTeardownRunner<BinomialHeap<int, std::less<int>, utils::TrivialFactory<BinomialHeapNode<int>>>>
+            binomial_heap_teardown("BinomialHeapTeardown", heap_uniform_pattern);
+    HeapTeardownRunner<PairingHeap<int, std::less<int>, utils::TrivialFactory<PairingHeapNode<int>>>>
+            pairing_heap_teardown("PairingHeapTeardown", heap_uniform_pattern);
+    HeapTeardownRunner<PairingHeap<int, std::less<int>, utils::TrivialFactory<PairingHeapNode<int>>>>
+            pairing_heap_path_teardown("PairingHeapPathTeardown", heap_descending_pattern);
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_HEAP_WORKLOAD_H
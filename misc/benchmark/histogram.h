@@ -0,0 +1,80 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_HISTOGRAM_H
+#define DATA_STRUCTURE_FOR_LOVE_HISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+namespace benchmark {
+    /*
+     * HDR style latency histogram. Values below 2 * SUB_BUCKETS are counted exactly; above, every power of two range
+     * [2^e, 2^(e+1)) is split into SUB_BUCKETS equal buckets, so a bucket is never wider than 1/SUB_BUCKETS (~3%)
+     * of the values it holds, from a few cycles up to the full 64 bit range in a fixed 15KB array.
+     * Recording is a count-leading-zeros, a shift and an increment, cheap enough for a timed loop.
+     */
+    class LatencyHistogram {
+    public:
+        constexpr static unsigned SUB_BITS = 5;
+        constexpr static uint64_t SUB_BUCKETS = 1u << SUB_BITS;
+        constexpr static size_t BUCKETS = (65 - SUB_BITS) * SUB_BUCKETS;
+
+        static size_t index(uint64_t value) noexcept {
+            if (value < 2 * SUB_BUCKETS) return value;
+            unsigned shift = 63 - __builtin_clzll(value) - SUB_BITS;
+            return shift * SUB_BUCKETS + (value >> shift);
+        }
+
+        static uint64_t lower(size_t bucket) noexcept {
+            if (bucket < 2 * SUB_BUCKETS) return bucket;
+            auto shift = bucket / SUB_BUCKETS - 1;
+            return (bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+        }
+
+        static uint64_t upper(size_t bucket) noexcept {
+            return bucket + 1 < BUCKETS ? lower(bucket + 1) - 1 : UINT64_MAX;
+        }
+
+        void record(uint64_t value) noexcept {
+            buckets[index(value)]++;
+            total++;
+            sum += value;
+            maximum = std::max(maximum, value);
+        }
+
+        void merge(const LatencyHistogram &that) noexcept {
+            for (size_t i = 0; i < BUCKETS; ++i) buckets[i] += that.buckets[i];
+            total += that.total;
+            sum += that.sum;
+            maximum = std::max(maximum, that.maximum);
+        }
+
+        void clear() noexcept {
+            buckets.fill(0);
+            total = sum = maximum = 0;
+        }
+
+        // highest value equivalent to the p-quantile (upper bound of its bucket), 0 <= p <= 1
+        uint64_t percentile(double p) const noexcept {
+            if (!total) return 0;
+            auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * total + 0.5));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                if ((seen += buckets[i]) >= rank) return std::min(maximum, upper(i));
+            }
+            return maximum;
+        }
+
+        uint64_t count() const noexcept { return total; }
+
+        uint64_t max() const noexcept { return maximum; }
+
+        double mean() const noexcept { return total ? static_cast<double>(sum) / total : 0; }
+
+        const std::array<uint64_t, BUCKETS> &raw() const noexcept { return buckets; }
+
+    private:
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t total = 0, sum = 0, maximum = 0;
+    };
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_HISTOGRAM_H
@@ -16,25 +16,15 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef INTSET_RUNNER
-#define INTSET_RUNNER
-
-    struct IntsetRunner : public BenchMark {
-        std::string name;
-
-        explicit IntsetRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class IntSet>
-    struct IntSetCheckingRunner : public IntsetRunner {
+    struct IntSetCheckingRunner : public BenchMark {
+
 
+        explicit IntSetCheckingRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 3000) {}
 
-        explicit IntSetCheckingRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        size_t operations(size_t n) override { return 1u << 16; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             IntSet tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -47,33 +37,23 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < (1u << 16); ++i) {
-                tree.contains(i);
+                timed([&] { tree.contains(i); });
             }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 3000; ++i) {
-                auto t = run(i);
-                if (i % 500 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
     template<>
-    struct IntSetCheckingRunner<std::set<unsigned short>> : public IntsetRunner {
+    struct IntSetCheckingRunner<std::set<unsigned short>> : public BenchMark {
+
 
+        explicit IntSetCheckingRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 3000) {}
 
-        explicit IntSetCheckingRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        size_t operations(size_t n) override { return 1u << 16; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::set<unsigned short> tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -86,23 +66,11 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             for (auto i = 0; i < (1u << 16); ++i) {
-                tree.count(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 3000; ++i) {
-                auto t = run(i);
-                if (i % 500 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
+                timed([&] { tree.count(i); });
             }
-            return result;
+            return stop();
         }
     };
 
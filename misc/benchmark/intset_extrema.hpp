@@ -16,25 +16,15 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef INTSET_RUNNER
-#define INTSET_RUNNER
-
-    struct IntsetRunner : public BenchMark {
-        std::string name;
-
-        explicit IntsetRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class IntSet>
-    struct IntSetExtremaRunner : public IntsetRunner {
+    struct IntSetExtremaRunner : public BenchMark {
+
 
+        explicit IntSetExtremaRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 5000) {}
 
-        explicit IntSetExtremaRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        size_t operations(size_t n) override { return 2; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             IntSet tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -47,32 +37,22 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             tree.min();
             tree.max();
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 5000; ++i) {
-                auto t = run(i);
-                if (i % 500 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
     template<>
-    struct IntSetExtremaRunner<std::set<unsigned short>> : public IntsetRunner {
+    struct IntSetExtremaRunner<std::set<unsigned short>> : public BenchMark {
+
 
+        explicit IntSetExtremaRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 5000) {}
 
-        explicit IntSetExtremaRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        size_t operations(size_t n) override { return 2; }
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             std::set<unsigned short> tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -85,22 +65,10 @@ namespace benchmark {
             for (auto i : vec) {
                 tree.insert(i);
             }
-            auto a = time_now();
+            start();
             tree.begin();
             --tree.end();
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 5000; ++i) {
-                auto t = run(i);
-                if (i % 500 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
@@ -16,25 +16,13 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef INTSET_RUNNER
-#define INTSET_RUNNER
-
-    struct IntsetRunner : public BenchMark {
-        std::string name;
-
-        explicit IntsetRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class IntSet>
-    struct IntSetInsertionRunner : public IntsetRunner {
+    struct IntSetInsertionRunner : public BenchMark {
 
 
-        explicit IntSetInsertionRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        explicit IntSetInsertionRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 5000) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             IntSet tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -43,23 +31,11 @@ namespace benchmark {
             }
             std::random_shuffle(vec.begin(), vec.end());
             vec.resize(n);
-            auto a = time_now();
+            start();
             for (auto i : vec) {
-                tree.insert(i);
-            }
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 5000; ++i) {
-                auto t = run(i);
-                if (i % 1000 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
+                timed([&] { tree.insert(i); });
             }
-            return result;
+            return stop();
         }
     };
 
@@ -16,25 +16,13 @@
 namespace benchmark {
     using namespace data_structure;
 
-#ifndef INTSET_RUNNER
-#define INTSET_RUNNER
-
-    struct IntsetRunner : public BenchMark {
-        std::string name;
-
-        explicit IntsetRunner(std::string name) noexcept : name(std::move(name)), BenchMark() {}
-    };
-
-#endif
-
-
     template<class IntSet>
-    struct IntSetIterationRunner : public IntsetRunner {
+    struct IntSetIterationRunner : public BenchMark {
 
 
-        explicit IntSetIterationRunner(std::string name) noexcept : IntsetRunner(std::move(name)) {}
+        explicit IntSetIterationRunner(std::string name) noexcept : BenchMark(std::move(name), 1, 3000) {}
 
-        long long run(size_t n) {
+        long long run(size_t n) override {
             IntSet tree;
             std::vector<unsigned short> vec;
             vec.reserve(1u << 16);
@@ -48,21 +36,9 @@ namespace benchmark {
                 tree.insert(i);
             }
             auto iter = tree.begin();
-            auto a = time_now();
+            start();
             while (iter != tree.end()) iter++;
-            auto b = time_now();
-            return (b - a).count();
-        }
-
-        Result run() override {
-            Result result;
-            result.name = name;
-            for (auto i = 1; i <= 3000; ++i) {
-                auto t = run(i);
-                if (i % 500 == 0) std::cout << name << ": " << i << std::endl;
-                result.outcomes.emplace_back(i, t);
-            }
-            return result;
+            return stop();
         }
     };
 
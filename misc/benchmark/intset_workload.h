@@ -0,0 +1,78 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_INTSET_WORKLOAD_H
+#define DATA_STRUCTURE_FOR_LOVE_INTSET_WORKLOAD_H
+
+#include "benchmark.h"
+#include "workload.h"
+#include <van_emde_boas.hpp>
+#include <x_fast_trie.hpp>
+#include <y_fast_trie.hpp>
+#include <binary_trie.hpp>
+#include <functional>
+#include <set>
+
+namespace benchmark {
+    using namespace data_structure;
+
+    /*
+     * Insert n distinct random keys, then answer 2^16 membership queries drawn from a shaped distribution.
+     */
+    template<class IntSet>
+    struct IntSetPatternCheckingRunner : public BenchMark {
+        std::function<std::vector<unsigned short>(workload::Engine &)> pattern;
+
+        IntSetPatternCheckingRunner(std::string name,
+                                    std::function<std::vector<unsigned short>(workload::Engine &)> pattern)
+                : BenchMark(std::move(name), 1, 3000), pattern(std::move(pattern)) {}
+
+        size_t operations(size_t n) override { return 1u << 16; }
+
+        long long run(size_t n) override {
+            IntSet tree;
+            auto vec = workload::permutation<unsigned short>(rand.eng, 1u << 16);
+            vec.resize(n);
+            for (auto i : vec) {
+                tree.insert(i);
+            }
+            auto queries = pattern(rand.eng);
+            size_t found = 0;
+            start();
+            for (auto i : queries) {
+                timed([&] { found += workload::lookup(tree, i); });
+            }
+            do_not_optimize(found);
+            return stop();
+        }
+    };
+
+    inline std::vector<unsigned short> intset_hot_cold_pattern(workload::Engine &eng) {
+        return workload::hot_cold<unsigned short>(eng, 1u << 16, 1u << 16);
+    }
+
+    inline std::vector<unsigned short> intset_sliding_window_pattern(workload::Engine &eng) {
+        return workload::sliding_window<unsigned short>(eng, (1u << 16) - 256, 256);
+    }
+
+    IntSetPatternCheckingRunner<std::set<unsigned short>> stl_int_set_hot_cold("STLIntSetHotColdChecking",
+                                                                              intset_hot_cold_pattern);
+    IntSetPatternCheckingRunner<VebTree<unsigned short>> veb_tree_hot_cold("VebTreeHotColdChecking",
+                                                                          intset_hot_cold_pattern);
+    IntSetPatternCheckingRunner<BinaryTrie<unsigned short>> binary_trie_hot_cold("BinaryTrieHotColdChecking",
+                                                                                intset_hot_cold_pattern);
+    IntSetPatternCheckingRunner<XFastTrie<unsigned short>> x_fast_trie_hot_cold("XFastTrieHotColdChecking",
+                                                                               intset_hot_cold_pattern);
+    IntSetPatternCheckingRunner<YFastTrie<unsigned short>> y_fast_trie_hot_cold("YFastTrieHotColdChecking",
+                                                                               intset_hot_cold_pattern);
+
+    IntSetPatternCheckingRunner<std::set<unsigned short>> stl_int_set_sliding("STLIntSetSlidingChecking",
+                                                                             intset_sliding_window_pattern);
+    IntSetPatternCheckingRunner<VebTree<unsigned short>> veb_tree_sliding("VebTreeSlidingChecking",
+                                                                         intset_sliding_window_pattern);
+    IntSetPatternCheckingRunner<BinaryTrie<unsigned short>> binary_trie_sliding("BinaryTrieSlidingChecking",
+                                                                               intset_sliding_window_pattern);
+    IntSetPatternCheckingRunner<XFastTrie<unsigned short>> x_fast_trie_sliding("XFastTrieSlidingChecking",
+                                                                              intset_sliding_window_pattern);
+    IntSetPatternCheckingRunner<YFastTrie<unsigned short>> y_fast_trie_sliding("YFastTrieSlidingChecking",
+                                                                              intset_sliding_window_pattern);
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_INTSET_WORKLOAD_H
@@ -0,0 +1,145 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_JSON_H
+#define DATA_STRUCTURE_FOR_LOVE_JSON_H
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cctype>
+
+namespace benchmark::json {
+    /*
+     * Just enough JSON to read back the files written by report.h.
+     */
+    struct Value {
+        enum Type {
+            NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT
+        } type = NUL;
+        bool boolean = false;
+        double number = 0;
+        std::string string;
+        std::vector<Value> array;
+        std::map<std::string, Value> object;
+
+        bool has(const std::string &key) const { return type == OBJECT && object.count(key); }
+
+        const Value &operator[](const std::string &key) const {
+            auto i = object.find(key);
+            if (type != OBJECT || i == object.end()) throw std::runtime_error("json: missing key " + key);
+            return i->second;
+        }
+    };
+
+    class Parser {
+        const std::string &text;
+        size_t pos = 0;
+
+        [[noreturn]] void fail(const std::string &what) const {
+            throw std::runtime_error("json: " + what + " at offset " + std::to_string(pos));
+        }
+
+        void skip() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        }
+
+        void expect(char c) {
+            skip();
+            if (pos >= text.size() || text[pos] != c) fail(std::string("expected '") + c + "'");
+            ++pos;
+        }
+
+        bool literal(const char *word) {
+            auto len = std::char_traits<char>::length(word);
+            if (text.compare(pos, len, word) != 0) return false;
+            pos += len;
+            return true;
+        }
+
+        std::string parse_string() {
+            expect('"');
+            std::string res;
+            while (pos < text.size() && text[pos] != '"') {
+                auto c = text[pos++];
+                if (c == '\\') {
+                    if (pos >= text.size()) fail("unterminated escape");
+                    switch (c = text[pos++]) {
+                        case 'n':
+                            res += '\n';
+                            break;
+                        case 't':
+                            res += '\t';
+                            break;
+                        default:
+                            res += c;
+                    }
+                } else res += c;
+            }
+            if (pos >= text.size()) fail("unterminated string");
+            ++pos;
+            return res;
+        }
+
+    public:
+        explicit Parser(const std::string &text) : text(text) {}
+
+        Value parse() {
+            Value v;
+            skip();
+            if (pos >= text.size()) fail("unexpected end");
+            auto c = text[pos];
+            if (c == '{') {
+                v.type = Value::OBJECT;
+                ++pos;
+                skip();
+                if (text[pos] == '}') {
+                    ++pos;
+                    return v;
+                }
+                do {
+                    auto key = parse_string();
+                    expect(':');
+                    v.object.emplace(std::move(key), parse());
+                    skip();
+                } while (text[pos] == ',' && ++pos);
+                expect('}');
+            } else if (c == '[') {
+                v.type = Value::ARRAY;
+                ++pos;
+                skip();
+                if (text[pos] == ']') {
+                    ++pos;
+                    return v;
+                }
+                do {
+                    v.array.push_back(parse());
+                    skip();
+                } while (text[pos] == ',' && ++pos);
+                expect(']');
+            } else if (c == '"') {
+                v.type = Value::STRING;
+                v.string = parse_string();
+            } else if (literal("true")) {
+                v.type = Value::BOOL;
+                v.boolean = true;
+            } else if (literal("false")) {
+                v.type = Value::BOOL;
+            } else if (literal("null")) {
+                v.type = Value::NUL;
+            } else {
+                char *end = nullptr;
+                v.type = Value::NUMBER;
+                v.number = std::strtod(text.c_str() + pos, &end);
+                if (end == text.c_str() + pos) fail("unexpected character");
+                pos = end - text.c_str();
+            }
+            return v;
+        }
+    };
+
+    inline Value parse(const std::string &text) {
+        return Parser(text).parse();
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_JSON_H
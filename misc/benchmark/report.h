@@ -0,0 +1,124 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_REPORT_H
+#define DATA_STRUCTURE_FOR_LOVE_REPORT_H
+
+#include "benchmark.h"
+#include <ctime>
+#include <ostream>
+
+namespace benchmark {
+    /*
+     * Output schema, version 1.
+     *
+     * JSON:
+     *   { "schema": 1,
+     *     "context": { "date", "seed", "repetitions", "warmup", "counters": [available counter names] },
+     *     "benchmarks": [ { "name", "results": [ {
+     *         "size", "operations",
+     *         "ns": { "min", "median", "p90", "p99", "max", "mean", "stddev" },
+     *         "ns_per_op", "ops_per_sec", "allocations", "bytes_allocated", "peak_bytes", "peak_rss_kb",
+     *         "counters": { <name>: mean count per run, only for available counters },
+     *         "latency": { "count", "mean", "p50", "p90", "p99", "p999", "max" }, per operation ns, only with --latency
+     *         "samples": [ns of every recorded run] } ] } ] }
+     *
+     * CSV: one row per (benchmark, size) with the same scalar fields, counters and latency left empty when unavailable.
+     * peak_rss_kb is the largest peak resident set size of the process during one recorded run, 0 when the peak
+     * could not be reset before the runs.
+     */
+    constexpr int schema_version = 1;
+
+    inline std::string json_escape(const std::string &s) {
+        std::string res;
+        for (auto c : s) {
+            switch (c) {
+                case '"':
+                    res += "\\\"";
+                    break;
+                case '\\':
+                    res += "\\\\";
+                    break;
+                case '\n':
+                    res += "\\n";
+                    break;
+                default:
+                    res += c;
+            }
+        }
+        return res;
+    }
+
+    void write_json(std::ostream &out, const std::vector<BenchMark::Result> &results, const Options &options) {
+        auto date = std::time(nullptr);
+        out << "{\n  \"schema\": " << schema_version << ",\n"
+            << "  \"context\": {\"date\": " << date << ", \"seed\": " << seed
+            << ", \"repetitions\": " << options.repetitions << ", \"warmup\": " << options.warmup
+            << ", \"counters\": [";
+        bool first = true;
+        for (size_t i = 0; perf_counters && i < PerfCounters::EVENT_COUNT; ++i) {
+            if (!perf_counters->available(static_cast<PerfCounters::Event>(i))) continue;
+            out << (first ? "" : ", ") << "\"" << PerfCounters::names[i] << "\"";
+            first = false;
+        }
+        out << "]},\n  \"benchmarks\": [";
+        for (size_t r = 0; r < results.size(); ++r) {
+            auto &result = results[r];
+            out << (r ? "," : "") << "\n    {\"name\": \"" << json_escape(result.name) << "\", \"results\": [";
+            for (size_t k = 0; k < result.outcomes.size(); ++k) {
+                auto &s = result.outcomes[k];
+                out << (k ? "," : "") << "\n      {\"size\": " << s.size << ", \"operations\": " << s.operations
+                    << ", \"ns\": {\"min\": " << s.min << ", \"median\": " << s.median << ", \"p90\": " << s.p90
+                    << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << ", \"mean\": " << s.mean
+                    << ", \"stddev\": " << s.stddev << "}"
+                    << ", \"ns_per_op\": " << s.ns_per_op() << ", \"ops_per_sec\": " << s.ops_per_sec()
+                    << ", \"allocations\": " << s.allocations << ", \"bytes_allocated\": " << s.bytes_allocated
+                    << ", \"peak_bytes\": " << s.peak_bytes << ", \"peak_rss_kb\": " << s.peak_rss_kb
+                    << ", \"counters\": {";
+                first = true;
+                for (size_t i = 0; perf_counters && i < PerfCounters::EVENT_COUNT; ++i) {
+                    if (!perf_counters->available(static_cast<PerfCounters::Event>(i))) continue;
+                    out << (first ? "" : ", ") << "\"" << PerfCounters::names[i] << "\": " << s.counters[i];
+                    first = false;
+                }
+                out << "}";
+                if (s.latency.count) {
+                    auto &l = s.latency;
+                    out << ", \"latency\": {\"count\": " << l.count << ", \"mean\": " << l.mean << ", \"p50\": " << l.p50
+                        << ", \"p90\": " << l.p90 << ", \"p99\": " << l.p99 << ", \"p999\": " << l.p999
+                        << ", \"max\": " << l.max << "}";
+                }
+                out << ", \"samples\": [";
+                for (size_t i = 0; i < s.samples.size(); ++i) out << (i ? ", " : "") << s.samples[i];
+                out << "]}";
+            }
+            out << "\n    ]}";
+        }
+        out << "\n  ]\n}" << std::endl;
+    }
+
+    void write_csv(std::ostream &out, const std::vector<BenchMark::Result> &results) {
+        out << "name,size,operations,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns,"
+               "ns_per_op,ops_per_sec,allocations,bytes_allocated,peak_bytes,peak_rss_kb";
+        for (auto i : PerfCounters::names) out << "," << i;
+        out << ",latency_count,latency_mean_ns,latency_p50_ns,latency_p90_ns,latency_p99_ns,latency_p999_ns,latency_max_ns\n";
+        for (auto &result : results) {
+            for (auto &s : result.outcomes) {
+                out << result.name << "," << s.size << "," << s.operations << "," << s.min << "," << s.median
+                    << "," << s.p90 << "," << s.p99 << "," << s.max << "," << s.mean << "," << s.stddev
+                    << "," << s.ns_per_op() << "," << s.ops_per_sec() << "," << s.allocations
+                    << "," << s.bytes_allocated << "," << s.peak_bytes << "," << s.peak_rss_kb;
+                for (size_t i = 0; i < PerfCounters::EVENT_COUNT; ++i) {
+                    out << ",";
+                    if (perf_counters && perf_counters->available(static_cast<PerfCounters::Event>(i)))
+                        out << s.counters[i];
+                }
+                auto &l = s.latency;
+                if (l.count) {
+                    out << "," << l.count << "," << l.mean << "," << l.p50 << "," << l.p90 << "," << l.p99
+                        << "," << l.p999 << "," << l.max;
+                } else out << ",,,,,,,";
+                out << "\n";
+            }
+        }
+        out.flush();
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_REPORT_H
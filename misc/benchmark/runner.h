@@ -0,0 +1,128 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_RUNNER_H
+#define DATA_STRUCTURE_FOR_LOVE_RUNNER_H
+
+#include "benchmark.h"
+#include "report.h"
+#include "compare.h"
+#include <memory>
+
+namespace benchmark {
+    void Options::usage(const char *program) {
+        std::cerr << "usage: " << program << " [options]\n"
+                  << "    --filter <regex>     only run benchmarks whose name matches\n"
+                  << "    --min-size <n>       skip sizes smaller than n\n"
+                  << "    --max-size <n>       skip sizes larger than n\n"
+                  << "    --step <n>           distance between two measured sizes (default 1)\n"
+                  << "    --repetitions <n>    recorded runs per size (default 5)\n"
+                  << "    --warmup <n>         unrecorded runs per size (default 1)\n"
+                  << "    --format <json|csv>  output format (default json)\n"
+                  << "    --output <file>      output file (default benchmark.<format>)\n"
+                  << "    --no-counters        do not read hardware counters\n"
+                  << "    --latency            time every operation on its own and report p50/p99/p99.9/max\n"
+                  << "    --baseline <file>    rerun the benchmarks of a previous json output and compare against it,\n"
+                  << "                         exit with status 2 when some benchmark regressed\n"
+                  << "    --alpha <p>          significance level of the comparison (default 0.01)\n"
+                  << "    --threshold <r>      ignore median slowdowns below this ratio (default 0.05)\n"
+                  << "    --list               print the registered benchmarks and exit\n";
+    }
+
+    Options Options::parse(int argc, char **argv) {
+        Options options;
+        auto value = [&](int &i) -> std::string {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+        auto number = [&](int &i) -> size_t { return std::stoull(value(i)); };
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--filter") options.filter = std::regex(value(i));
+            else if (arg == "--min-size") options.min_size = number(i);
+            else if (arg == "--max-size") options.max_size = number(i);
+            else if (arg == "--step") options.step = std::max<size_t>(1, number(i));
+            else if (arg == "--repetitions") options.repetitions = std::max<size_t>(1, number(i));
+            else if (arg == "--warmup") options.warmup = number(i);
+            else if (arg == "--format") options.format = value(i);
+            else if (arg == "--output") options.output = value(i);
+            else if (arg == "--no-counters") options.counters = false;
+            else if (arg == "--latency") options.latency = true;
+            else if (arg == "--list") options.list = true;
+            else if (arg == "--baseline") options.baseline = value(i);
+            else if (arg == "--alpha") options.alpha = std::stod(value(i));
+            else if (arg == "--threshold") options.threshold = std::stod(value(i));
+            else {
+                usage(argv[0]);
+                std::exit(arg == "--help" || arg == "-h" ? 0 : 1);
+            }
+        }
+        if (options.format != "json" && options.format != "csv") {
+            usage(argv[0]);
+            std::exit(1);
+        }
+        if (options.output.empty()) options.output = "benchmark." + options.format;
+        return options;
+    }
+
+    int run_all(int argc, char **argv) {
+        auto options = Options::parse(argc, argv);
+        if (options.list) {
+            for (auto i : benchmarks) {
+                if (std::regex_search(i->name, options.filter))
+                    std::cout << i->name << " [" << i->first << ", " << i->last << "]" << std::endl;
+            }
+            return 0;
+        }
+        Baseline baseline;
+        if (!options.baseline.empty()) {
+            try {
+                baseline = load_baseline(options.baseline);
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        }
+        std::unique_ptr<PerfCounters> counters;
+        if (options.counters) {
+            counters = std::make_unique<PerfCounters>();
+            if (counters->available()) perf_counters = counters.get();
+            else std::cerr << "hardware counters are not available, running without them" << std::endl;
+        }
+        std::vector<BenchMark::Result> results;
+        for (auto i : benchmarks) {
+            if (!std::regex_search(i->name, options.filter)) continue;
+            if (options.baseline.empty()) results.push_back(i->run(options));
+            else {
+                auto old = baseline.find(i->name);
+                if (old == baseline.end()) continue;
+                std::vector<size_t> sizes;
+                for (auto &j : old->second) sizes.push_back(j.first);
+                results.push_back(i->run(sizes, options));
+            }
+            if (!results.back().outcomes.empty()) {
+                auto &back = results.back().outcomes.back();
+                std::cout << i->name << ": size " << back.size << ", median " << back.median
+                          << "ns, " << back.ns_per_op() << "ns/op, p99 " << back.p99 << "ns, peak "
+                          << back.peak_bytes << "B";
+                if (back.latency.count) {
+                    std::cout << "; per op p50 " << back.latency.p50 << "ns, p99 " << back.latency.p99
+                              << "ns, p99.9 " << back.latency.p999 << "ns, max " << back.latency.max << "ns";
+                }
+                std::cout << std::endl;
+            }
+        }
+        std::ofstream out(options.output);
+        if (options.format == "csv") write_csv(out, results);
+        else write_json(out, results, options);
+        perf_counters = nullptr;
+        if (options.baseline.empty()) return 0;
+        for (auto &i : baseline) {
+            if (std::none_of(benchmarks.begin(), benchmarks.end(), [&](auto b) { return b->name == i.first; }))
+                std::cerr << "benchmark " << i.first << " of the baseline is not registered any more" << std::endl;
+        }
+        auto regressions = print_comparison(std::cout, compare(baseline, results, options.alpha, options.threshold));
+        return regressions ? 2 : 0;
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_RUNNER_H
@@ -0,0 +1,169 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_TRACE_H
+#define DATA_STRUCTURE_FOR_LOVE_TRACE_H
+
+#include "workload.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace benchmark::trace {
+    /*
+     * Binary trace file, version 1:
+     *   header:  8 byte magic "DSFLTRC1", then the number of records as little endian uint64 (0 when unknown)
+     *   records: one byte operation (workload::Op), then the difference to the previous key (the first one to 0),
+     *            zigzag encoded as an unsigned LEB128 varint.
+     * Keys are signed 64 bit. Traces of clustered keys need 2-3 bytes per operation.
+     */
+    constexpr char magic[8] = {'D', 'S', 'F', 'L', 'T', 'R', 'C', '1'};
+    constexpr size_t header_size = 16;
+
+    using Record = workload::Operation<long long>;
+
+    class Writer {
+    public:
+        explicit Writer(const std::string &path) : out(path, std::ios::binary | std::ios::trunc) {
+            if (!out) throw std::runtime_error("cannot create trace " + path);
+            out.write(magic, sizeof(magic));
+            put_fixed(0);
+            buffer.reserve(buffer_capacity);
+        }
+
+        Writer(const Writer &) = delete;
+
+        Writer &operator=(const Writer &) = delete;
+
+        ~Writer() { close(); }
+
+        void record(workload::Op op, long long key) {
+            buffer.push_back(static_cast<char>(op));
+            auto delta = static_cast<uint64_t>(key) - static_cast<uint64_t>(last);
+            auto zigzag = (delta << 1u) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+            do {
+                buffer.push_back(static_cast<char>((zigzag & 0x7fu) | (zigzag > 0x7fu ? 0x80u : 0u)));
+                zigzag >>= 7u;
+            } while (zigzag);
+            last = key;
+            records++;
+            if (buffer.size() >= buffer_capacity) flush();
+        }
+
+        void record(const Record &r) { record(r.op, r.key); }
+
+        // flush the records and patch their number into the header
+        void close() {
+            if (!out.is_open()) return;
+            flush();
+            out.seekp(sizeof(magic));
+            put_fixed(records);
+            out.close();
+        }
+
+        uint64_t size() const noexcept { return records; }
+
+    private:
+        constexpr static size_t buffer_capacity = 1u << 20;
+        std::ofstream out;
+        std::string buffer;
+        long long last = 0;
+        uint64_t records = 0;
+
+        void flush() {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+
+        void put_fixed(uint64_t value) {
+            char bytes[8];
+            for (auto &b : bytes) b = static_cast<char>(value & 0xffu), value >>= 8u;
+            out.write(bytes, sizeof(bytes));
+        }
+    };
+
+    /*
+     * Streams the records of a trace straight out of a read only memory mapping. Pages that have been consumed
+     * are handed back to the kernel, so a trace larger than memory replays with a small resident set.
+     */
+    class Reader {
+    public:
+        explicit Reader(const std::string &path) {
+            fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("cannot open trace " + path);
+            struct stat st{};
+            fstat(fd, &st);
+            length = static_cast<size_t>(st.st_size);
+            if (length < header_size) {
+                ::close(fd);
+                throw std::runtime_error(path + " is not a trace file");
+            }
+            auto p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map trace " + path);
+            }
+            base = static_cast<const unsigned char *>(p);
+            madvise(p, length, MADV_SEQUENTIAL);
+            if (std::memcmp(base, magic, sizeof(magic)) != 0) {
+                unmap();
+                throw std::runtime_error(path + " is not a trace file");
+            }
+            for (size_t i = 0; i < 8; ++i) records |= static_cast<uint64_t>(base[sizeof(magic) + i]) << (8 * i);
+            pos = released = header_size;
+        }
+
+        Reader(const Reader &) = delete;
+
+        Reader &operator=(const Reader &) = delete;
+
+        ~Reader() { unmap(); }
+
+        // number of records announced by the header, 0 if the writer did not finish
+        uint64_t size() const noexcept { return records; }
+
+        bool next(Record &r) {
+            if (pos >= length) return false;
+            r.op = static_cast<workload::Op>(base[pos++]);
+            if (static_cast<size_t>(r.op) >= workload::OP_COUNT) throw std::runtime_error("corrupted trace record");
+            uint64_t zigzag = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                if (pos >= length || shift > 63) throw std::runtime_error("truncated trace record");
+                auto byte = base[pos++];
+                zigzag |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+                if (!(byte & 0x80u)) break;
+            }
+            auto delta = (zigzag >> 1u) ^ (~(zigzag & 1u) + 1);
+            last = static_cast<long long>(static_cast<uint64_t>(last) + delta);
+            r.key = last;
+            if (pos - released >= release_step) release();
+            return true;
+        }
+
+    private:
+        constexpr static size_t release_step = 64u << 20;
+        int fd = -1;
+        const unsigned char *base = nullptr;
+        size_t length = 0, pos = 0, released = 0;
+        uint64_t records = 0;
+        long long last = 0;
+
+        void unmap() noexcept {
+            if (base) munmap(const_cast<unsigned char *>(base), length);
+            if (fd >= 0) ::close(fd);
+            base = nullptr;
+            fd = -1;
+        }
+
+        void release() {
+            auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            auto end = pos / page * page;
+            auto begin = released / page * page;
+            if (end > begin) madvise(const_cast<unsigned char *>(base) + begin, end - begin, MADV_DONTNEED);
+            released = end;
+        }
+    };
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_TRACE_H
@@ -0,0 +1,202 @@
+// Record operation traces of ordered containers and replay them against every implementation:
+//     trace_replay record <file> [--ops n] [--preload n] [--universe n] [--keys uniform|zipf|hot-cold|sliding]
+//                                [--mix find,insert,erase,succ,pred] [--seed n]
+//     trace_replay replay <file> [--containers name,name,...] [--buckets]
+//     trace_replay info <file>
+//
+
+#include "trace.h"
+#include "histogram.h"
+#include "cycle_clock.h"
+#include <avl_tree.hpp>
+#include <b_plus_tree.hpp>
+#include <rb_tree.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <scapegoat.hpp>
+#include <skip_list.hpp>
+#include <van_emde_boas.hpp>
+#include <y_fast_trie.hpp>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+using namespace benchmark;
+using namespace data_structure;
+
+struct ReplayStats {
+    LatencyHistogram latency[workload::OP_COUNT];
+    uint64_t hits[workload::OP_COUNT]{};
+    long long wall_ns = 0;
+};
+
+long long identity_key(long long key) { return key; }
+
+// the integer sets are instantiated on int and only take non negative keys
+int intset_key(long long key) { return static_cast<int>(key & 0x7fffffffll); }
+
+/*
+ * Replay the whole trace, streaming it from the mapping, and time every operation on its own with the cycle clock.
+ */
+template<class Set, class Key>
+ReplayStats replay(const std::string &path, Key (*convert)(long long)) {
+    Set set;
+    trace::Reader reader(path);
+    trace::Record record{};
+    ReplayStats stats;
+    auto begin = std::chrono::steady_clock::now();
+    while (reader.next(record)) {
+        auto key = convert(record.key);
+        auto op = static_cast<size_t>(record.op);
+        auto start = CycleClock::now();
+        auto hit = workload::apply(set, record.op, key);
+        stats.latency[op].record(CycleClock::now() - start);
+        stats.hits[op] += hit;
+    }
+    stats.wall_ns = (std::chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+const std::map<std::string, std::function<ReplayStats(const std::string &)>> containers = {
+        {"RbTree",    [](auto &p) { return replay<RbTree<long long>>(p, identity_key); }},
+        {"AVLTree",   [](auto &p) { return replay<AVLTree<long long>>(p, identity_key); }},
+        {"Treap",     [](auto &p) { return replay<Treap<long long>>(p, identity_key); }},
+        {"Splay",     [](auto &p) { return replay<Splay<long long>>(p, identity_key); }},
+        {"ScapeGoat", [](auto &p) { return replay<ScapeGoat<long long>>(p, identity_key); }},
+        {"BPlusTree", [](auto &p) { return replay<BPlusTree<long long>>(p, identity_key); }},
+        {"SkipList",  [](auto &p) { return replay<SkipList<long long>>(p, identity_key); }},
+        {"VebTree",   [](auto &p) { return replay<VebTree<int>>(p, intset_key); }},
+        {"YFastTrie", [](auto &p) { return replay<YFastTrie<int>>(p, intset_key); }},
+        {"std::set",  [](auto &p) { return replay<std::set<long long>>(p, identity_key); }},
+};
+
+void usage() {
+    std::cerr << "usage:\n"
+              << "    trace_replay record <file> [--ops n] [--preload n] [--universe n]\n"
+              << "                 [--keys uniform|zipf|hot-cold|sliding] [--mix find,insert,erase,succ,pred] [--seed n]\n"
+              << "    trace_replay replay <file> [--containers name,...] [--buckets]\n"
+              << "    trace_replay info <file>\n"
+              << "containers:";
+    for (auto &i : containers) std::cerr << " " << i.first;
+    std::cerr << std::endl;
+}
+
+std::vector<std::string> split(const std::string &s) {
+    std::vector<std::string> res;
+    std::stringstream in(s);
+    for (std::string item; std::getline(in, item, ',');) res.push_back(item);
+    return res;
+}
+
+int record(const std::string &path, const std::vector<std::string> &args) {
+    size_t ops = 1'000'000, preload = 0, universe = 1'000'000;
+    std::string keys = "zipf";
+    workload::Mix mix{0.6, 0.2, 0.1, 0.05, 0.05};
+    workload::Engine eng(std::chrono::steady_clock::now().time_since_epoch().count());
+    for (size_t i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--ops") ops = std::stoull(args[i + 1]);
+        else if (args[i] == "--preload") preload = std::stoull(args[i + 1]);
+        else if (args[i] == "--universe") universe = std::max<size_t>(1, std::stoull(args[i + 1]));
+        else if (args[i] == "--keys") keys = args[i + 1];
+        else if (args[i] == "--seed") eng.seed(std::stoull(args[i + 1]));
+        else if (args[i] == "--mix") {
+            auto w = split(args[i + 1]);
+            if (w.size() != workload::OP_COUNT) return usage(), 1;
+            mix = {std::stod(w[0]), std::stod(w[1]), std::stod(w[2]), std::stod(w[3]), std::stod(w[4])};
+        } else return usage(), 1;
+    }
+    if (args.size() % 2) return usage(), 1;
+    std::vector<long long> sequence;
+    if (keys == "uniform") sequence = workload::uniform<long long>(eng, ops, universe);
+    else if (keys == "zipf") sequence = workload::zipf<long long>(eng, ops, universe);
+    else if (keys == "hot-cold") sequence = workload::hot_cold<long long>(eng, ops, universe);
+    else if (keys == "sliding") sequence = workload::sliding_window<long long>(eng, ops, universe);
+    else return usage(), 1;
+    trace::Writer writer(path);
+    for (auto k : workload::uniform<long long>(eng, preload, universe)) writer.record(workload::Op::Insert, k);
+    for (auto &i : workload::trace(eng, sequence, mix)) writer.record(i);
+    writer.close();
+    std::cout << "recorded " << writer.size() << " operations into " << path << std::endl;
+    return 0;
+}
+
+int info(const std::string &path) {
+    trace::Reader reader(path);
+    trace::Record r{};
+    uint64_t count[workload::OP_COUNT]{}, total = 0;
+    long long lo = std::numeric_limits<long long>::max(), hi = std::numeric_limits<long long>::min();
+    while (reader.next(r)) {
+        count[static_cast<size_t>(r.op)]++;
+        total++;
+        lo = std::min(lo, r.key);
+        hi = std::max(hi, r.key);
+    }
+    std::cout << path << ": " << total << " operations";
+    if (total) std::cout << ", keys in [" << lo << ", " << hi << "]";
+    std::cout << "\n";
+    for (size_t i = 0; i < workload::OP_COUNT; ++i) std::cout << "  " << workload::op_names[i] << ": " << count[i] << "\n";
+    std::cout.flush();
+    return 0;
+}
+
+void print(const std::string &name, const ReplayStats &stats, bool buckets) {
+    auto ns = [](double ticks) { return static_cast<uint64_t>(CycleClock::to_ns(ticks)); };
+    uint64_t total = 0;
+    for (auto &i : stats.latency) total += i.count();
+    std::cout << name << ": " << total << " operations in " << stats.wall_ns / 1e6 << "ms ("
+              << (stats.wall_ns ? total * 1e3 / stats.wall_ns : 0) << " Mops/s)\n"
+              << "  " << std::left << std::setw(8) << "op" << std::right << std::setw(12) << "count"
+              << std::setw(12) << "hits" << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(12) << "max (ns)" << "\n";
+    for (size_t i = 0; i < workload::OP_COUNT; ++i) {
+        auto &h = stats.latency[i];
+        if (!h.count()) continue;
+        std::cout << "  " << std::left << std::setw(8) << workload::op_names[i] << std::right
+                  << std::setw(12) << h.count() << std::setw(12) << stats.hits[i]
+                  << std::setw(10) << ns(h.mean()) << std::setw(10) << ns(h.percentile(0.5))
+                  << std::setw(10) << ns(h.percentile(0.99)) << std::setw(10) << ns(h.percentile(0.999))
+                  << std::setw(12) << ns(h.max()) << "\n";
+        if (!buckets) continue;
+        for (size_t b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+            if (h.raw()[b]) std::cout << "      <= " << ns(LatencyHistogram::upper(b)) << "ns: " << h.raw()[b] << "\n";
+        }
+    }
+    std::cout.flush();
+}
+
+int replay(const std::string &path, const std::vector<std::string> &args) {
+    std::vector<std::string> selected;
+    bool buckets = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--containers" && i + 1 < args.size()) selected = split(args[++i]);
+        else if (args[i] == "--buckets") buckets = true;
+        else return usage(), 1;
+    }
+    if (selected.empty()) for (auto &i : containers) selected.push_back(i.first);
+    for (auto &name : selected) {
+        auto c = containers.find(name);
+        if (c == containers.end()) return usage(), 1;
+        print(name, c->second(path), buckets);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) return usage(), 1;
+    std::string command = argv[1], path = argv[2];
+    std::vector<std::string> args(argv + 3, argv + argc);
+    try {
+        if (command == "record") return record(path, args);
+        if (command == "replay") return replay(path, args);
+        if (command == "info" && args.empty()) return info(path);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    usage();
+    return 1;
+}
@@ -0,0 +1,278 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_WORKLOAD_H
+#define DATA_STRUCTURE_FOR_LOVE_WORKLOAD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+#include <static_random_helper.hpp>
+
+/*
+ * Key sequences and operation traces shared by the tree, heap and intset suites.
+ * Every generator draws from the engine it is given (usually BenchMark::rand.eng), so a run is reproducible
+ * from the benchmark seed. Keys are in [0, universe) unless documented otherwise.
+ */
+namespace benchmark::workload {
+    using Engine = std::mt19937_64;
+
+    template<class Key = int>
+    std::vector<Key> uniform(Engine &eng, size_t n, size_t universe) {
+        std::uniform_int_distribution<size_t> dist{0, universe - 1};
+        std::vector<Key> res(n);
+        for (auto &i : res) i = static_cast<Key>(dist(eng));
+        return res;
+    }
+
+    // 0, 1, ..., n - 1 in random order
+    template<class Key = int>
+    std::vector<Key> permutation(Engine &eng, size_t n) {
+        std::vector<Key> res(n);
+        std::iota(res.begin(), res.end(), Key{});
+        std::shuffle(res.begin(), res.end(), eng);
+        return res;
+    }
+
+    /*
+     * Zipf distributed keys: rank r is drawn with probability proportional to 1 / r^s.
+     * Ranks are mapped to keys through a random permutation, so the popular keys are spread over the universe
+     * instead of being the smallest ones.
+     */
+    template<class Key = int>
+    std::vector<Key> zipf(Engine &eng, size_t n, size_t universe, double s = 0.99) {
+        std::vector<double> cdf(universe);
+        double sum = 0;
+        for (size_t i = 0; i < universe; ++i) cdf[i] = sum += 1.0 / std::pow(i + 1, s);
+        auto keys = permutation<Key>(eng, universe);
+        data_structure::utils::RandomRealGen<double> real(0, sum);
+        real.eng.seed(eng());
+        std::vector<Key> res(n);
+        for (auto &i : res) {
+            auto rank = std::lower_bound(cdf.begin(), cdf.end(), real()) - cdf.begin();
+            i = keys[std::min<size_t>(rank, universe - 1)];
+        }
+        return res;
+    }
+
+    /*
+     * A `hot_fraction` of the universe receives `hot_probability` of the accesses, the rest is uniform over the cold keys.
+     */
+    template<class Key = int>
+    std::vector<Key> hot_cold(Engine &eng, size_t n, size_t universe, double hot_fraction = 0.1,
+                              double hot_probability = 0.9) {
+        auto hot = std::max<size_t>(1, static_cast<size_t>(universe * hot_fraction));
+        std::bernoulli_distribution pick_hot{hot_probability};
+        std::uniform_int_distribution<size_t> hot_key{0, hot - 1}, cold_key{std::min(hot, universe - 1), universe - 1};
+        std::vector<Key> res(n);
+        for (auto &i : res) i = static_cast<Key>(pick_hot(eng) ? hot_key(eng) : cold_key(eng));
+        return res;
+    }
+
+    /*
+     * The i-th key is uniform in [i, i + window): accesses drift slowly through the key space,
+     * which rewards structures with temporal and spatial locality. Keys are in [0, n + window).
+     */
+    template<class Key = int>
+    std::vector<Key> sliding_window(Engine &eng, size_t n, size_t window) {
+        std::uniform_int_distribution<size_t> dist{0, std::max<size_t>(window, 1) - 1};
+        std::vector<Key> res(n);
+        for (size_t i = 0; i < n; ++i) res[i] = static_cast<Key>(i + dist(eng));
+        return res;
+    }
+
+    /*
+     * 0, 1, ..., n - 1 with `disorder * n` random swaps of elements at most `distance` apart.
+     */
+    template<class Key = int>
+    std::vector<Key> nearly_sorted(Engine &eng, size_t n, double disorder = 0.01, size_t distance = 16) {
+        std::vector<Key> res(n);
+        std::iota(res.begin(), res.end(), Key{});
+        if (n < 2) return res;
+        std::uniform_int_distribution<size_t> pos{0, n - 1}, offset{1, std::max<size_t>(1, distance)};
+        for (auto swaps = static_cast<size_t>(disorder * n); swaps; --swaps) {
+            auto i = pos(eng), j = std::min(n - 1, i + offset(eng));
+            std::swap(res[i], res[j]);
+        }
+        return res;
+    }
+
+    /*
+     * A permutation of [0, n) made of `teeth` ascending runs, the k-th run being k, k + teeth, k + 2 * teeth, ...
+     * Every run sweeps the whole key range again.
+     */
+    template<class Key = int>
+    std::vector<Key> sawtooth(size_t n, size_t teeth = 8) {
+        std::vector<Key> res;
+        res.reserve(n);
+        teeth = std::max<size_t>(1, teeth);
+        for (size_t k = 0; k < teeth; ++k)
+            for (auto i = k; i < n; i += teeth) res.push_back(static_cast<Key>(i));
+        return res;
+    }
+
+    /*
+     * 0, n - 1, 1, n - 2, ...: every key lands at an alternate end of the current order.
+     * This defeats the locality of splay trees, keeps scapegoat trees rebuilding both flanks,
+     * and makes each heap push alternately a new minimum and a new maximum.
+     */
+    template<class Key = int>
+    std::vector<Key> adversarial(size_t n) {
+        std::vector<Key> res;
+        res.reserve(n);
+        for (size_t lo = 0, hi = n; lo < hi;) {
+            res.push_back(static_cast<Key>(lo++));
+            if (lo < hi) res.push_back(static_cast<Key>(--hi));
+        }
+        return res;
+    }
+
+    enum class Op : uint8_t {
+        Find, Insert, Erase, Succ, Pred
+    };
+
+    constexpr size_t OP_COUNT = 5;
+
+    constexpr const char *op_names[OP_COUNT] = {"find", "insert", "erase", "succ", "pred"};
+
+    template<class Key = int>
+    struct Operation {
+        Op op;
+        Key key;
+    };
+
+    // relative weights of the operations in a trace, they need not sum to one
+    struct Mix {
+        double find = 0.8, insert = 0.1, erase = 0.1, succ = 0, pred = 0;
+    };
+
+    /*
+     * Interleave operations with the given mix, the i-th operation touching keys[i].
+     */
+    template<class Key>
+    std::vector<Operation<Key>> trace(Engine &eng, const std::vector<Key> &keys, Mix mix = {}) {
+        std::discrete_distribution<int> pick{mix.find, mix.insert, mix.erase, mix.succ, mix.pred};
+        std::vector<Operation<Key>> res;
+        res.reserve(keys.size());
+        for (auto k : keys) res.push_back({static_cast<Op>(pick(eng)), k});
+        return res;
+    }
+
+    // trees and integer sets answer contains, std::set only count
+    template<class Set, class Key>
+    auto lookup(Set &set, const Key &key, int) -> decltype(static_cast<bool>(set.contains(key))) {
+        return set.contains(key);
+    }
+
+    template<class Set, class Key>
+    bool lookup(Set &set, const Key &key, long) {
+        return set.count(key) != 0;
+    }
+
+    template<class Set, class Key>
+    bool lookup(Set &set, const Key &key) {
+        return lookup(set, key, 0);
+    }
+
+    /*
+     * Set semantics for every container: SkipList keeps duplicates and the integer sets require
+     * that inserted keys are absent and erased keys present, so their void insert/erase are guarded by a lookup.
+     */
+    template<class Set, class Key>
+    auto insert_unique(Set &set, const Key &key, int) -> decltype(static_cast<bool>(set.insert(key))) {
+        return set.insert(key);
+    }
+
+    template<class Set, class Key>
+    auto insert_unique(Set &set, const Key &key, int) -> decltype(set.insert(key).second) {
+        return set.insert(key).second;
+    }
+
+    template<class Set, class Key>
+    bool insert_unique(Set &set, const Key &key, long) {
+        if (lookup(set, key)) return false;
+        set.insert(key);
+        return true;
+    }
+
+    template<class Set, class Key>
+    bool insert_unique(Set &set, const Key &key) {
+        return insert_unique(set, key, 0);
+    }
+
+    template<class Set, class Key>
+    auto erase_existing(Set &set, const Key &key, int) -> decltype(static_cast<bool>(set.erase(key))) {
+        return set.erase(key);
+    }
+
+    template<class Set, class Key>
+    bool erase_existing(Set &set, const Key &key, long) {
+        if (!lookup(set, key)) return false;
+        set.erase(key);
+        return true;
+    }
+
+    template<class Set, class Key>
+    bool erase_existing(Set &set, const Key &key) {
+        return erase_existing(set, key, 0);
+    }
+
+    // succ/pred answer an optional (skip list, integer sets) or a walker (binary search trees)
+    template<class T>
+    bool found(const std::optional<T> &result) { return result.has_value(); }
+
+    template<class Walker>
+    auto found(Walker walker) -> decltype(walker.valid()) { return walker.valid(); }
+
+    template<class Set, class Key>
+    auto successor(Set &set, const Key &key, int) -> decltype(found(set.succ(key))) {
+        return found(set.succ(key));
+    }
+
+    template<class Set, class Key>
+    bool successor(Set &set, const Key &key, long) {
+        return set.upper_bound(key) != set.end();
+    }
+
+    template<class Set, class Key>
+    auto predecessor(Set &set, const Key &key, int) -> decltype(found(set.pred(key))) {
+        return found(set.pred(key));
+    }
+
+    template<class Set, class Key>
+    bool predecessor(Set &set, const Key &key, long) {
+        return set.lower_bound(key) != set.begin();
+    }
+
+    /*
+     * Apply one operation; returns whether it hit (key found, inserted, erased, neighbour exists).
+     */
+    template<class Set, class Key>
+    bool apply(Set &set, Op op, const Key &key) {
+        switch (op) {
+            case Op::Find:
+                return lookup(set, key);
+            case Op::Insert:
+                return insert_unique(set, key);
+            case Op::Erase:
+                return erase_existing(set, key);
+            case Op::Succ:
+                return successor(set, key, 0);
+            case Op::Pred:
+                return predecessor(set, key, 0);
+        }
+        return false;
+    }
+
+    /*
+     * Play a trace against a set; returns the number of operations that hit so that the work is observable.
+     */
+    template<class Set, class Key>
+    size_t replay(Set &set, const std::vector<Operation<Key>> &ops) {
+        size_t hits = 0;
+        for (auto &i : ops) hits += apply(set, i.op, i.key);
+        return hits;
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_WORKLOAD_H
@@ -0,0 +1,23 @@
+# Benchmarks are measured on optimized code only: whatever the build profile is,
+# they are compiled with -O3 and without asserts or coverage instrumentation.
+if (DSFL_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT BENCHMARK_LTO_SUPPORTED OUTPUT BENCHMARK_LTO_ERROR LANGUAGES CXX)
+    if (NOT BENCHMARK_LTO_SUPPORTED)
+        message(STATUS "LTO is not supported for the benchmark: ${BENCHMARK_LTO_ERROR}")
+    endif ()
+endif ()
+
+function(benchmark_target name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} data_structure_for_love)
+    target_compile_definitions(${name} PRIVATE NDEBUG)
+    # appended after the profile flags, so it wins over -O0 of Debug/Coverage
+    target_compile_options(${name} PRIVATE -O3)
+    if (DSFL_NATIVE)
+        target_compile_options(${name} PRIVATE -march=native)
+    endif ()
+    if (DSFL_LTO AND BENCHMARK_LTO_SUPPORTED)
+        set_target_properties(${name} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+    endif ()
+endfunction()
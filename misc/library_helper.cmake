@@ -3,3 +3,19 @@ function (set_library name)
     add_library(lib_${name} STATIC ${LIBFILE_${name}})
     SET_TARGET_PROPERTIES(lib_${name} PROPERTIES LINKER_LANGUAGE CXX)
 endfunction()
+
+# Header only interface library. The headers include each other by bare file name,
+# so every directory is exported as an include directory and the headers are
+# installed side by side into include/${name}.
+function(header_library name)
+    add_library(${name} INTERFACE)
+    add_library(${name}::${name} ALIAS ${name})
+    target_compile_features(${name} INTERFACE cxx_std_17)
+    foreach (dir ${ARGN})
+        target_include_directories(${name} INTERFACE $<BUILD_INTERFACE:${PROJECT_SOURCE_DIR}/${dir}>)
+        install(DIRECTORY ${dir}/ DESTINATION include/${name} FILES_MATCHING PATTERN "*.hpp")
+    endforeach ()
+    target_include_directories(${name} INTERFACE $<INSTALL_INTERFACE:include/${name}>)
+    install(TARGETS ${name} EXPORT ${name}Config)
+    install(EXPORT ${name}Config NAMESPACE ${name}:: DESTINATION lib/cmake/${name})
+endfunction()
@@ -0,0 +1,167 @@
+#include <augmented_tree.hpp>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+// the first and the last element of a range: combine is not commutative, so a fold in the wrong order shows
+struct Ends {
+    using value_type = std::pair<int, int>;
+
+    static value_type identity() { return {-1, -1}; }
+
+    static value_type lift(const int &x) { return {x, x}; }
+
+    static value_type combine(const value_type &a, const value_type &b) {
+        if (a.first < 0) return b;
+        if (b.first < 0) return a;
+        return {a.first, b.second};
+    }
+};
+
+struct Polynomial {
+    // a range x1 < ... < xk as the value of x1 * 31^(k-1) + ... + xk modulo 2^64, with 31^k
+    using value_type = std::pair<unsigned long long, unsigned long long>;
+
+    static value_type identity() { return {0, 1}; }
+
+    static value_type lift(const int &x) { return {x, 31}; }
+
+    static value_type combine(const value_type &a, const value_type &b) {
+        return {a.first * b.second + b.first, a.second * b.second};
+    }
+};
+
+template<template<class, class, class> class Tree, class Monoid>
+void check_fold(int range, size_t rounds) {
+    Tree<int, AugmentedBSTNode<int, Monoid>, utils::DefaultCompare<int>> tree;
+    std::set<int> set;
+    for (size_t round = 1; round <= rounds; ++round) {
+        auto x = get_rand() % range;
+        if (get_rand() % 3) {
+            tree.insert(x);
+            set.insert(x);
+        } else {
+            tree.erase(x);
+            set.erase(x);
+        }
+        // lookups rotate the splay tree as well
+        tree.contains(get_rand() % range);
+        if (round % 300) continue;
+        for (auto i = 0; i < 50; ++i) {
+            auto lo = get_rand() % range - range / 10, hi = lo + get_rand() % (range / 3);
+            auto expected = Monoid::identity();
+            for (auto it = set.lower_bound(lo); it != set.end() && *it <= hi; ++it) {
+                expected = Monoid::combine(expected, Monoid::lift(*it));
+            }
+            assert(tree.fold(lo, hi) == expected);
+        }
+        auto all = Monoid::identity();
+        for (auto y : set) all = Monoid::combine(all, Monoid::lift(y));
+        assert(!tree.top().valid() || tree.top().unsafe_cast()->summary == all);
+        assert(tree.fold(range, range + 10) == Monoid::identity());
+    }
+}
+
+template<template<class, class, class> class Tree>
+void check_all_monoids() {
+    check_fold<Tree, Ends>(2000, 20000);
+    check_fold<Tree, Polynomial>(2000, 20000);
+    check_fold<Tree, SumMonoid<long long>>(500, 10000);
+    check_fold<Tree, MinMonoid<int>>(500, 10000);
+    check_fold<Tree, MaxMonoid<int>>(500, 10000);
+    check_fold<Tree, CountMonoid<int>>(500, 10000);
+}
+
+template<template<class, class, class> class Tree>
+void check_intervals(int range, size_t rounds) {
+    IntervalTree<int, Tree> tree;
+    std::set<std::pair<int, int>> set;
+    for (size_t round = 1; round <= rounds; ++round) {
+        auto lo = get_rand() % range, hi = lo + get_rand() % (range / 20);
+        if (get_rand() % 3) assert(tree.insert(lo, hi) == set.insert({lo, hi}).second);
+        else if (!set.empty() && get_rand() % 2) {
+            auto x = *set.begin();
+            assert(tree.erase(x.first, x.second));
+            set.erase(x);
+        } else assert(tree.erase(lo, hi) == (set.erase({lo, hi}) == 1));
+        assert(tree.size() == set.size());
+        auto qlo = get_rand() % range, qhi = qlo + get_rand() % (range / 50);
+        std::vector<std::pair<int, int>> expected;
+        for (auto &x : set) if (x.first <= qhi && qlo <= x.second) expected.push_back(x);
+        auto found = tree.overlapping(qlo, qhi);
+        assert(found.size() == expected.size());
+        for (size_t i = 0; i < found.size(); ++i) {
+            assert(found[i].lo == expected[i].first && found[i].hi == expected[i].second);
+        }
+        assert(tree.overlaps(qlo, qhi) == !expected.empty());
+        auto stabbed = tree.stab(qlo);
+        for (auto &x : stabbed) assert(x.lo <= qlo && qlo <= x.hi);
+    }
+}
+
+template<template<class, class, class> class Tree>
+void check_map(int range, size_t rounds) {
+    AggregateMap<int, long long, SumMonoid<long long>, Tree> map;
+    AggregateMap<int, int, MaxMonoid<int>, Tree> max;
+    std::map<int, long long> std_map;
+    for (size_t round = 1; round <= rounds; ++round) {
+        auto k = get_rand() % range;
+        auto v = get_rand() % 1000 - 500;
+        switch (get_rand() % 4) {
+            case 0:
+                assert(map.insert(k, v) == std_map.insert({k, v}).second);
+                max.insert(k, std_map[k]);
+                break;
+            case 1:
+                assert(map.erase(k) == (std_map.erase(k) == 1));
+                max.erase(k);
+                break;
+            default:
+                map.assign(k, v);
+                max.assign(k, v);
+                std_map[k] = v;
+        }
+        assert(map.size() == std_map.size() && map.contains(k) == (std_map.count(k) == 1));
+        if (std_map.count(k)) assert(map.find(k)->second == std_map[k]);
+        auto lo = get_rand() % range, hi = lo + get_rand() % (range / 4);
+        long long sum = 0;
+        int largest = std::numeric_limits<int>::lowest();
+        for (auto it = std_map.lower_bound(lo); it != std_map.end() && it->first <= hi; ++it) {
+            sum += it->second;
+            largest = std::max(largest, static_cast<int>(it->second));
+        }
+        assert(map.aggregate(lo, hi) == sum);
+        assert(max.aggregate(lo, hi) == largest);
+    }
+    auto it = map.begin();
+    for (auto &x : std_map) {
+        assert((*it).first == x.first && (*it).second == x.second);
+        ++it;
+    }
+}
+
+int main() {
+    check_all_monoids<AugmentedRbTree>();
+    check_all_monoids<AugmentedAVLTree>();
+    check_all_monoids<AugmentedTreap>();
+    check_all_monoids<AugmentedSplay>();
+    check_intervals<AugmentedRbTree>(10000, 20000);
+    check_intervals<AugmentedAVLTree>(10000, 20000);
+    check_intervals<AugmentedTreap>(10000, 20000);
+    check_intervals<AugmentedSplay>(10000, 20000);
+    check_intervals<AugmentedRbTree>(200, 5000);
+    check_map<AugmentedRbTree>(3000, 30000);
+    check_map<AugmentedAVLTree>(3000, 30000);
+    check_map<AugmentedTreap>(3000, 30000);
+    check_map<AugmentedSplay>(3000, 30000);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <b_plus_tree.hpp>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+struct Reversed {
+    constexpr utils::Relation operator()(const int &a, const int &b) const noexcept {
+        return a == b ? utils::Eq : a > b ? utils::Less : utils::Greater;
+    }
+};
+
+// the tree and a std::set with the same order must agree on every query
+template<class Tree, class Set>
+void compare_with(Tree &tree, Set &set, const typename Set::key_type &x) {
+    assert(tree.size() == set.size());
+    assert(tree.contains(x) == (set.count(x) == 1));
+    auto found = tree.find(x);
+    assert(found.valid() == (set.count(x) == 1));
+    if (found.valid()) assert(*found == x);
+    auto succ = tree.succ(x);
+    auto upper = set.upper_bound(x);
+    assert(succ.valid() == (upper != set.end()));
+    if (succ.valid()) assert(*succ == *upper);
+    auto pred = tree.pred(x);
+    auto lower = set.lower_bound(x);
+    assert(pred.valid() == (lower != set.begin()));
+    if (pred.valid()) assert(*pred == *std::prev(lower));
+    assert(tree.min().valid() == !set.empty());
+    if (!set.empty()) assert(*tree.min() == *set.begin() && *tree.max() == *set.rbegin());
+}
+
+template<class Tree, class Set, class Gen>
+void check_random(size_t range, size_t rounds, Gen gen) {
+    Tree tree;
+    Set set;
+    for (size_t i = 0; i < rounds; ++i) {
+        auto x = gen(get_rand() % range);
+        if (get_rand() % 5 < 3) assert(tree.insert(x) == set.insert(x).second);
+        else assert(tree.erase(x) == (set.erase(x) == 1));
+        compare_with(tree, set, gen(get_rand() % range));
+    }
+    auto it = tree.begin();
+    for (auto &x : set) {
+        assert(it != tree.end() && *it == x);
+        ++it;
+    }
+    assert(it == tree.end());
+    for (auto x = set.rbegin(); x != set.rend(); ++x) assert(*--it == *x);
+    assert(it == tree.begin());
+    while (!set.empty()) {
+        auto x = *set.begin();
+        assert(tree.erase(x) && !tree.erase(x));
+        set.erase(x);
+        compare_with(tree, set, x);
+    }
+    assert(tree.begin() == tree.end());
+}
+
+// ascending and descending runs split and merge the nodes at the edges of the tree only
+void check_sequential() {
+    BPlusTree<int, utils::DefaultCompare<int>, 1> tree;
+    for (auto i = 0; i < 100000; ++i) assert(tree.insert(i));
+    for (auto i = 0; i < 100000; ++i) assert(*tree.succ(i - 1) == i);
+    for (auto i = 99999; i >= 0; i -= 2) assert(tree.erase(i));
+    assert(tree.size() == 50000 && *tree.max() == 99998);
+    auto expected = 0;
+    for (auto x : tree) {
+        assert(x == expected);
+        expected += 2;
+    }
+    tree.clear();
+    assert(tree.size() == 0 && !tree.min().valid());
+    for (auto i = 0; i < 1000; ++i) tree.insert(-i);
+    BPlusTree<int, utils::DefaultCompare<int>, 1> moved(std::move(tree));
+    assert(moved.size() == 1000 && *moved.min() == -999 && tree.size() == 0);
+}
+
+int main() {
+    auto identity = [](int x) { return x; };
+    check_random<BPlusTree<int, utils::DefaultCompare<int>, 1>, std::set<int>>(64, 100000, identity);
+    check_random<BPlusTree<int, utils::DefaultCompare<int>, 1>, std::set<int>>(20000, 200000, identity);
+    check_random<BPlusTree<int>, std::set<int>>(1000000, 200000, identity);
+    check_random<BPlusTree<int, Reversed, 1>, std::set<int, std::greater<>>>(5000, 100000, identity);
+    check_random<BPlusTree<std::string, utils::DefaultCompare<std::string>, 2>, std::set<std::string>>(
+            5000, 100000, [](int x) { return std::to_string(x); });
+    check_sequential();
+    return 0;
+}
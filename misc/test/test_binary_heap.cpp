@@ -1,11 +1,37 @@
 #include <iostream>
 #include <binary_heap.hpp>
 #include <cstdlib>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+#include <random>
 #include <object_pool.hpp>
 std::mt19937_64 eng{};
 std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
 #define get_rand() dist(eng)
 
+// counts the copies made of it, the heap itself should only move
+struct Tracked {
+    static inline size_t copies = 0;
+    int value;
+
+    explicit Tracked(int value) : value(value) {}
+
+    Tracked(const Tracked &that) : value(that.value) { copies++; }
+
+    Tracked(Tracked &&that) noexcept = default;
+
+    Tracked &operator=(const Tracked &that) {
+        value = that.value;
+        copies++;
+        return *this;
+    }
+
+    Tracked &operator=(Tracked &&that) noexcept = default;
+
+    bool operator<(const Tracked &that) const { return value < that.value; }
+};
+
 inline auto random_string() {
     std::string test{};
     auto len = get_rand() % 233;
@@ -42,5 +68,55 @@ int main() {
     }
     std::sort(test_two.begin(), test_two.end());
     assert(test_two == res_two);
+
+    // bulk construction
+    n = 100000;
+    std::vector<int> test_three;
+    while (n--) test_three.push_back(get_rand() % 1000);
+    BinaryHeap<int> bHeap_three(test_three.begin(), test_three.end());
+    BinaryHeap<int> bHeap_four(test_three);
+    BinaryHeap<int> bHeap_five{5, 3, 9, 1, 7};
+    assert(bHeap_three.size() == test_three.size() && bHeap_four.size() == test_three.size());
+    std::sort(test_three.begin(), test_three.end());
+    for (auto i : test_three) {
+        assert(bHeap_three.top() == i && bHeap_four.top() == i);
+        bHeap_three.pop();
+        bHeap_four.pop();
+    }
+    assert(bHeap_three.empty() && bHeap_four.empty());
+    bHeap_four.pop();
+    assert(bHeap_four.empty());
+    for (auto i : {1, 3, 5, 7, 9}) {
+        assert(bHeap_five.top() == i);
+        bHeap_five.pop();
+    }
+
+    // emplace, rvalue push and pop never copy
+    BinaryHeap<Tracked> bHeap_six;
+    for (int i = 0; i < 1000; ++i) {
+        if (i & 1) bHeap_six.emplace(get_rand());
+        else bHeap_six.push(Tracked(get_rand()));
+    }
+    for (int last = -1; !bHeap_six.empty(); bHeap_six.pop()) {
+        assert(bHeap_six.top().value >= last);
+        last = bHeap_six.top().value;
+    }
+    assert(Tracked::copies == 0);
+
+    {
+        // bulk loading into an empty heap, then a large and a small batch into a non empty one
+        std::vector<int> keys(20000), res;
+        for (auto &k : keys) k = static_cast<int>(get_rand() % 1000);
+        BinaryHeap<int> bulk(keys.begin(), keys.begin() + 5000);
+        bulk.push_range(keys.begin() + 5000, keys.end() - 10);
+        bulk.push_range(keys.end() - 10, keys.end());
+        assert(bulk.size() == keys.size());
+        while (!bulk.empty()) {
+            res.push_back(bulk.top());
+            bulk.pop();
+        }
+        std::sort(keys.begin(), keys.end());
+        assert(res == keys);
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <concurrent_skip_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+// without concurrency both pops see every element, and try_pop takes them in order
+void check_sequential() {
+    ConcurrentSkipQueue<int> queue(8);
+    std::vector<int> vec;
+    for (auto i = 0; i < 100000; ++i) {
+        auto k = get_rand() % 5000;
+        queue.push(k);
+        vec.push_back(k);
+    }
+    assert(queue.size() == vec.size());
+    std::sort(vec.begin(), vec.end());
+    for (auto i = 0; i < 50000; ++i) {
+        auto res = queue.try_pop();
+        assert(res && *res == vec[i]);
+    }
+    queue.reclaim();
+    std::vector<int> rest;
+    while (auto res = queue.try_pop_relaxed()) rest.push_back(*res);
+    assert(queue.empty() && !queue.try_pop() && !queue.try_pop_relaxed());
+    std::sort(rest.begin(), rest.end());
+    assert(std::equal(rest.begin(), rest.end(), vec.begin() + 50000, vec.end()));
+}
+
+// a relaxed pop returns one of the smallest elements, rank being the number of smaller ones left
+void check_relaxed_rank() {
+    ConcurrentSkipQueue<size_t> queue(16);
+    for (size_t i = 0; i < 100000; ++i) queue.emplace(i);
+    std::vector<bool> popped(100000);
+    size_t smallest = 0, worst = 0;
+    for (auto i = 0; i < 50000; ++i) {
+        auto res = queue.try_pop_relaxed();
+        assert(res && !popped[*res]);
+        auto rank = std::count(popped.begin() + smallest, popped.begin() + *res, false);
+        worst = std::max(worst, static_cast<size_t>(rank));
+        popped[*res] = true;
+        while (popped[smallest]) ++smallest;
+    }
+    // O(p log^3 p) with high probability, about a thousand for p = 16
+    assert(worst < 10000);
+}
+
+// producers and consumers race, every element must come out exactly once
+void check_concurrent(bool relaxed) {
+    constexpr size_t threads = 4, per_thread = 50000;
+    ConcurrentSkipQueue<size_t> queue(threads);
+    std::atomic<size_t> produced{0}, consumed{0};
+    std::vector<std::vector<size_t>> popped(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 local(t);
+            for (size_t i = 0; i < per_thread; ++i) {
+                queue.push(local() % 1000 * threads * per_thread + t * per_thread + i);
+                produced.fetch_add(1);
+            }
+        });
+        workers.emplace_back([&, t] {
+            while (consumed.load() < threads * per_thread) {
+                auto res = relaxed ? queue.try_pop_relaxed() : queue.try_pop();
+                // approximate, but never wrapped below 0
+                assert(queue.size() <= threads * per_thread);
+                if (!res) continue;
+                popped[t].push_back(*res);
+                consumed.fetch_add(1);
+            }
+        });
+    }
+    for (auto &i : workers) i.join();
+    assert(produced.load() == threads * per_thread && queue.empty() && !queue.try_pop());
+    std::vector<bool> seen(threads * per_thread);
+    for (auto &v : popped) {
+        for (auto k : v) {
+            auto id = k % (threads * per_thread);
+            assert(!seen[id]);
+            seen[id] = true;
+        }
+    }
+    assert(std::all_of(seen.begin(), seen.end(), [](bool b) { return b; }));
+}
+
+// once the producers are done, a single consumer takes the elements in order
+void check_quiescent_order() {
+    constexpr size_t threads = 4;
+    ConcurrentSkipQueue<std::string, utils::DefaultCompare<std::string>> queue(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 local(t);
+            for (auto i = 0; i < 20000; ++i) {
+                queue.push(std::to_string(local() % 100000));
+                if (i % 4 == 0) queue.try_pop();
+            }
+        });
+    }
+    for (auto &i : workers) i.join();
+    assert(queue.size() == threads * 15000);
+    std::string last;
+    while (auto res = queue.try_pop()) {
+        assert(last <= *res);
+        last = std::move(*res);
+    }
+}
+
+int main() {
+    check_sequential();
+    check_relaxed_rank();
+    check_concurrent(false);
+    check_concurrent(true);
+    check_quiescent_order();
+    return 0;
+}
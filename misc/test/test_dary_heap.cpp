@@ -0,0 +1,104 @@
+#include <dary_heap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+inline auto random_string() {
+    std::string test{};
+    auto len = get_rand() % 233;
+    while (len--) {
+        test.push_back(static_cast<char>(get_rand() % 128));
+    }
+    return test;
+}
+
+template<size_t D>
+void check_ints() {
+    using namespace data_structure;
+    DaryHeap<int, D, std::greater<>> heap{};
+    std::vector<int> test, res;
+    for (auto n = 114514; n--;) {
+        test.push_back(get_rand());
+        if (n & 1) heap.push(test.back());
+        else heap.emplace(test.back());
+        if (n % 1000 == 0) {
+            // sibling groups are aligned to their size, so they never straddle a cache line
+            assert(reinterpret_cast<uintptr_t>(&heap.top() + 1) % (D * sizeof(int)) == 0);
+        }
+    }
+    while (!heap.empty()) {
+        res.push_back(heap.top());
+        heap.pop();
+    }
+    std::sort(test.begin(), test.end(), std::greater<int>{});
+    assert(test == res);
+
+    test.clear();
+    for (auto n = 100000; n--;) test.push_back(get_rand() % 1000);
+    DaryHeap<int, D> built(test.begin(), test.end());
+    auto copy = built;
+    std::sort(test.begin(), test.end());
+    for (auto i : test) {
+        assert(built.top() == i && copy.top() == i);
+        built.pop();
+        copy.pop();
+    }
+    assert(built.empty() && copy.empty());
+    built.pop();
+    assert(built.size() == 0);
+}
+
+int main() {
+    using namespace data_structure;
+    check_ints<2>();
+    check_ints<4>();
+    check_ints<8>();
+    check_ints<16>();
+
+    DaryHeap<std::string, 4> strings{};
+    std::vector<std::string> test, res;
+    for (auto n = 5261; n--;) {
+        test.push_back(random_string());
+        strings.push(test.back());
+    }
+    auto moved = std::move(strings);
+    assert(strings.empty() && moved.size() == test.size());
+    strings = moved;
+    while (!moved.empty()) {
+        res.push_back(moved.top());
+        moved.pop();
+    }
+    std::sort(test.begin(), test.end());
+    assert(test == res);
+    assert(strings.size() == test.size() && strings.top() == test.front());
+
+    {
+        // bulk loading into an empty heap, then a large and a small batch into a non empty one
+        std::vector<int> keys(20000), res;
+        for (auto &k : keys) k = static_cast<int>(get_rand() % 1000);
+        DaryHeap<int, 8> bulk(keys.begin(), keys.begin() + 5000);
+        bulk.push_range(keys.begin() + 5000, keys.end() - 10);
+        bulk.push_range(keys.end() - 10, keys.end());
+        assert(bulk.size() == keys.size());
+        while (!bulk.empty()) {
+            res.push_back(bulk.top());
+            bulk.pop();
+        }
+        std::sort(keys.begin(), keys.end());
+        assert(res == keys);
+    }
+
+    DaryHeap<int, 8> small{3, 1, 2};
+    assert(small.top() == 1);
+    small.clear();
+    assert(small.empty());
+    return 0;
+}
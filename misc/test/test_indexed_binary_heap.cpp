@@ -0,0 +1,102 @@
+#include <indexed_binary_heap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+// push, decrease_key, erase and pop at random, checked against a std::map of the (distinct) live values
+template<class Heap>
+void check_handles() {
+    Heap heap;
+    std::map<int, typename Heap::handle> live;
+    for (int round = 0; round < 200000; ++round) {
+        auto op = get_rand() % 8;
+        if (live.empty() || op < 3) {
+            int v = get_rand();
+            if (!live.count(v)) live[v] = heap.push(v);
+        } else if (op < 5) {
+            auto it = live.lower_bound(get_rand());
+            if (it == live.end()) it = live.begin();
+            auto v = it->first - 1 - get_rand() % 1000;
+            if (live.count(v)) continue;
+            auto h = it->second;
+            assert(heap.get(h) == it->first);
+            heap.decrease_key(h, v);
+            assert(heap.get(h) == v);
+            live.erase(it);
+            live[v] = h;
+        } else if (op < 7) {
+            auto it = live.lower_bound(get_rand());
+            if (it == live.end()) it = live.begin();
+            heap.erase(it->second);
+            live.erase(it);
+        } else {
+            heap.pop();
+            live.erase(live.begin());
+        }
+        assert(heap.size() == live.size());
+        if (!live.empty()) assert(heap.top() == live.begin()->first);
+    }
+    for (; !live.empty(); live.erase(live.begin())) {
+        assert(heap.top() == live.begin()->first);
+        heap.pop();
+    }
+    assert(heap.empty());
+}
+
+int main() {
+    using namespace data_structure;
+    {
+        IndexedBinaryHeap<std::string, std::greater<>> heap;
+        std::vector<std::string> test, res;
+        for (auto n = 10000; n--;) {
+            test.push_back(std::to_string(get_rand()));
+            heap.emplace(test.back());
+        }
+        while (!heap.empty()) {
+            res.push_back(heap.top());
+            heap.pop();
+        }
+        std::sort(test.begin(), test.end(), std::greater<>());
+        assert(res == test);
+    }
+    {
+        // ids of popped elements are handed out again, the live ones never move
+        IndexedBinaryHeap<int> heap;
+        auto a = heap.push(3), b = heap.push(1), c = heap.push(2);
+        heap.pop();
+        auto d = heap.push(5);
+        assert(d == b);
+        assert(heap.get(a) == 3 && heap.get(c) == 2 && heap.get(d) == 5);
+        heap.decrease_key(d, 0);
+        assert(heap.top() == 0);
+        heap.erase(c);
+        heap.pop();
+        assert(heap.size() == 1 && heap.top() == 3);
+    }
+    {
+        // bulk loading into an empty heap, then a large and a small batch into a non empty one
+        std::vector<int> keys(20000), res;
+        for (auto &k : keys) k = static_cast<int>(get_rand() % 1000);
+        IndexedBinaryHeap<int> bulk(keys.begin(), keys.begin() + 5000);
+        bulk.push_range(keys.begin() + 5000, keys.end() - 10);
+        bulk.push_range(keys.end() - 10, keys.end());
+        assert(bulk.size() == keys.size());
+        while (!bulk.empty()) {
+            res.push_back(bulk.top());
+            bulk.pop();
+        }
+        std::sort(keys.begin(), keys.end());
+        assert(res == keys);
+    }
+
+    check_handles<IndexedBinaryHeap<int>>();
+    return 0;
+}
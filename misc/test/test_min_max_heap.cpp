@@ -0,0 +1,93 @@
+#include <min_max_heap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+inline auto random_string() {
+    std::string test{};
+    auto len = get_rand() % 20;
+    while (len--) test.push_back(static_cast<char>('a' + get_rand() % 26));
+    return test;
+}
+
+// pushes and pops at both ends at random, next to a std::multiset
+template<class T, class Compare, class Gen>
+void check_random(Gen gen) {
+    MinMaxHeap<T, Compare> heap;
+    std::multiset<T, Compare> ref;
+    for (auto round = 0; round < 200000; ++round) {
+        assert(heap.size() == ref.size());
+        if (!ref.empty()) {
+            assert(heap.top_min() == *ref.begin() && heap.top() == *ref.begin());
+            assert(heap.top_max() == *ref.rbegin());
+        }
+        auto op = get_rand() % 8;
+        if (ref.empty() || op < 4) {
+            auto t = gen();
+            heap.push(t);
+            ref.insert(t);
+        } else if (op < 6) {
+            heap.pop_min();
+            ref.erase(ref.begin());
+        } else {
+            heap.pop_max();
+            ref.erase(std::prev(ref.end()));
+        }
+    }
+}
+
+// bulk construction and push_range, then drained from both ends alternately
+void check_bulk() {
+    for (auto n : {0, 1, 2, 3, 7, 8, 100, 12345}) {
+        std::vector<int> vec;
+        for (auto i = 0; i < n; ++i) vec.push_back(get_rand() % 1000);
+        MinMaxHeap<int> heap(vec.begin(), vec.end());
+        MinMaxHeap<int> grown{1, 5, 3};
+        grown.push_range(vec.begin(), vec.end());
+        grown.push_range(vec.begin(), vec.begin() + n / 10);
+        auto sorted = vec;
+        sorted.insert(sorted.end(), {1, 5, 3});
+        sorted.insert(sorted.end(), vec.begin(), vec.begin() + n / 10);
+        std::sort(sorted.begin(), sorted.end());
+        std::sort(vec.begin(), vec.end());
+        assert(heap.size() == vec.size() && grown.size() == sorted.size());
+        for (size_t lo = 0, hi = vec.size(); lo < hi;) {
+            if ((lo + vec.size() - hi) % 2) {
+                assert(heap.top_max() == vec[--hi]);
+                heap.pop_max();
+            } else {
+                assert(heap.top_min() == vec[lo++]);
+                heap.pop_min();
+            }
+        }
+        assert(heap.empty());
+        for (size_t lo = 0, hi = sorted.size(); lo < hi;) {
+            assert(grown.top_min() == sorted[lo++]);
+            grown.pop_min();
+            if (lo == hi) break;
+            assert(grown.top_max() == sorted[--hi]);
+            grown.pop_max();
+        }
+        assert(grown.empty());
+        grown.pop_min();
+        grown.pop_max();
+    }
+}
+
+int main() {
+    check_random<int, std::less<>>([] { return get_rand() % 1000; });
+    check_random<int, std::greater<>>([] { return get_rand(); });
+    check_random<std::string, std::less<>>(random_string);
+    check_bulk();
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <avl_tree.hpp>
+#include <rb_tree.hpp>
+#include <scapegoat.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+// rank, select and count_range after random insertions and erasures, checked against a sorted copy of a std::set
+template<class Tree>
+void check(int range, size_t rounds) {
+    Tree tree;
+    std::set<int> set;
+    for (size_t round = 1; round <= rounds; ++round) {
+        auto x = get_rand() % range;
+        if (get_rand() % 3) {
+            tree.insert(x);
+            set.insert(x);
+        } else {
+            tree.erase(x);
+            set.erase(x);
+        }
+        if (round % 500) continue;
+        std::vector<int> sorted(set.begin(), set.end());
+        for (size_t k = 0; k < sorted.size(); ++k) {
+            assert(tree.rank(sorted[k]) == k);
+            assert(*tree.select(k) == sorted[k]);
+        }
+        assert(!tree.select(sorted.size()).valid());
+        for (auto i = 0; i < 100; ++i) {
+            auto lo = get_rand() % range - range / 10, hi = lo + get_rand() % (range / 4);
+            auto expected = std::upper_bound(sorted.begin(), sorted.end(), hi) -
+                            std::lower_bound(sorted.begin(), sorted.end(), lo);
+            assert(tree.count_range(lo, hi) == static_cast<size_t>(expected));
+            assert(tree.rank(lo) == static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), lo) -
+                                                        sorted.begin()));
+            assert(tree.count_range(hi, lo) == (lo == hi ? static_cast<size_t>(expected) : 0));
+        }
+    }
+}
+
+// a sliding window percentile, the use case: the median of the last 1001 samples
+void check_window() {
+    RbTree<int, RBTNode<int, WeightedBSTNode<int>>> tree;
+    std::vector<int> samples;
+    std::multiset<int> window;
+    for (auto i = 0; i < 20000; ++i) {
+        // distinct samples, as the trees are sets
+        samples.push_back(i * 7919 % 20011);
+        tree.insert(samples.back());
+        window.insert(samples.back());
+        if (window.size() > 1001) {
+            tree.erase(samples[i - 1001]);
+            window.erase(samples[i - 1001]);
+        }
+        if (i % 997 == 0) assert(*tree.select(tree.size() / 2) == *std::next(window.begin(), window.size() / 2));
+    }
+}
+
+int main() {
+    check<ScapeGoat<int>>(3000, 30000);
+    check<RbTree<int, RBTNode<int, WeightedBSTNode<int>>>>(3000, 30000);
+    check<AVLTree<int, AVLNode<int, WeightedBSTNode<int>>>>(3000, 30000);
+    check<Treap<int, TreapNode<int, WeightedBSTNode<int>>>>(3000, 30000);
+    check<Splay<int, WeightedBSTNode<int>>>(3000, 30000);
+    check<BSTree<int, WeightedBSTNode<int>>>(3000, 30000);
+    check<RbTree<int, RBTNode<int, WeightedBSTNode<int>>>>(100, 20000);
+    check_window();
+    return 0;
+}
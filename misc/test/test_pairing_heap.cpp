@@ -4,8 +4,10 @@
 #include <pairing_heap.hpp>
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <random>
 #include <cassert>
+#include <map>
 
 std::mt19937_64 eng{};
 std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
@@ -21,6 +23,46 @@ inline auto random_string() {
     return test;
 }
 
+// push, decrease_key, erase and pop at random, checked against a std::map of the (distinct) live values
+template<class Heap>
+void check_handles() {
+    Heap heap;
+    std::map<int, typename Heap::handle> live;
+    for (int round = 0; round < 200000; ++round) {
+        auto op = get_rand() % 8;
+        if (live.empty() || op < 3) {
+            int v = get_rand();
+            if (!live.count(v)) live[v] = heap.push(v);
+        } else if (op < 5) {
+            auto it = live.lower_bound(get_rand());
+            if (it == live.end()) it = live.begin();
+            auto v = it->first - 1 - get_rand() % 1000;
+            if (live.count(v)) continue;
+            auto h = it->second;
+            assert(heap.get(h) == it->first);
+            heap.decrease_key(h, v);
+            assert(heap.get(h) == v);
+            live.erase(it);
+            live[v] = h;
+        } else if (op < 7) {
+            auto it = live.lower_bound(get_rand());
+            if (it == live.end()) it = live.begin();
+            heap.erase(it->second);
+            live.erase(it);
+        } else {
+            heap.pop();
+            live.erase(live.begin());
+        }
+        assert(heap.size() == live.size());
+        if (!live.empty()) assert(heap.top() == live.begin()->first);
+    }
+    for (; !live.empty(); live.erase(live.begin())) {
+        assert(heap.top() == live.begin()->first);
+        heap.pop();
+    }
+    assert(heap.empty());
+}
+
 signed main() {
     using namespace data_structure;
     PairingHeap<std::string> test;
@@ -83,4 +125,51 @@ signed main() {
         decrease2.pop();
     }
     assert(res_hb == test_hb);
-}
\ No newline at end of file
+
+    {
+        // bulk loading into an empty heap, then a large and a small batch into a non empty one
+        std::vector<int> keys(20000), res;
+        for (auto &k : keys) k = static_cast<int>(get_rand() % 1000);
+        PairingHeap<int> bulk(keys.begin(), keys.begin() + 5000);
+        bulk.push_range(keys.begin() + 5000, keys.end() - 10);
+        bulk.push_range(keys.end() - 10, keys.end());
+        assert(bulk.size() == keys.size());
+        while (!bulk.empty()) {
+            res.push_back(bulk.top());
+            bulk.pop();
+        }
+        std::sort(keys.begin(), keys.end());
+        assert(res == keys);
+    }
+
+    {
+        // decreasing keys make a single path as deep as the heap: copying and destroying it must not recurse
+        PairingHeap<int, std::less<int>, utils::TrivialFactory<PairingHeapNode<int>>> chain;
+        for (auto i = 1000000; i > 0; --i) chain.push(i);
+        auto copied = chain;
+        for (auto i = 1; i <= 1000; ++i) {
+            assert(copied.top() == i);
+            copied.pop();
+        }
+        assert(copied.size() == 999000 && chain.size() == 1000000);
+    }
+
+    check_handles<PairingHeap<int>>();
+    check_handles<PairingHeap<int, std::less<int>, utils::TrivialFactory<PairingHeapNode<int>>>>();
+
+    // merging takes over the pool of the other heap: its nodes and handles outlive it
+    PairingHeap<std::string> merged;
+    std::vector<PairingHeap<std::string>::handle> handles;
+    for (auto k = 0; k < 8; ++k) {
+        PairingHeap<std::string> part;
+        for (auto i = 0; i < 1000; ++i) handles.push_back(part.push(std::to_string(1000000 + k * 1000 + i)));
+        merged.merge(part);
+        assert(part.empty());
+    }
+    for (auto h : handles) merged.decrease_key(h, "0" + merged.get(h));
+    for (auto i = 1000000; i < 1008000; ++i) {
+        assert(merged.top() == "0" + std::to_string(i));
+        merged.pop();
+    }
+    assert(merged.empty());
+}
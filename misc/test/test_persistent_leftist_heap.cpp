@@ -0,0 +1,117 @@
+#include <persistent_leftist_heap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+// counts the live values, every node must be freed once no heap refers to it
+struct Counted {
+    static inline long live = 0;
+    int value;
+
+    Counted(int value) : value(value) { live++; }
+
+    Counted(const Counted &that) : value(that.value) { live++; }
+
+    ~Counted() { live--; }
+
+    bool operator<(const Counted &that) const { return value < that.value; }
+};
+
+// forks, pops, pushes and merges on random versions, each checked against a std::multiset of its own
+void check_versions() {
+    {
+        std::vector<PersistentLeftistHeap<Counted>> heaps(1);
+        std::vector<std::multiset<int>> refs(1);
+        for (auto round = 0; round < 50000; ++round) {
+            auto i = get_rand() % heaps.size();
+            auto op = get_rand() % 10;
+            if (op == 0 && heaps.size() < 64) {
+                heaps.push_back(heaps[i]);
+                refs.push_back(refs[i]);
+            } else if (op == 1) {
+                auto j = get_rand() % heaps.size();
+                if (refs[i].size() + refs[j].size() > 2000) continue;
+                heaps[i].merge(heaps[j]);
+                auto other = refs[j];
+                refs[i].insert(other.begin(), other.end());
+            } else if (op == 2 && heaps.size() > 1) {
+                heaps[i] = heaps.back();
+                refs[i] = refs.back();
+                heaps.pop_back();
+                refs.pop_back();
+                i = std::min(i, heaps.size() - 1);
+            } else if (op < 6 || refs[i].empty()) {
+                auto k = get_rand() % 10000;
+                heaps[i].push(k);
+                refs[i].insert(k);
+            } else {
+                heaps[i].pop();
+                refs[i].erase(refs[i].begin());
+            }
+            for (auto j : {i, heaps.size() - 1}) {
+                assert(heaps[j].size() == refs[j].size() && heaps[j].empty() == refs[j].empty());
+                if (!refs[j].empty()) assert(heaps[j].top().value == *refs[j].begin());
+            }
+        }
+        for (size_t i = 0; i < heaps.size(); ++i) {
+            while (!refs[i].empty()) {
+                assert(heaps[i].top().value == *refs[i].begin());
+                heaps[i].pop();
+                refs[i].erase(refs[i].begin());
+            }
+            assert(heaps[i].empty());
+        }
+    }
+    assert(Counted::live == 0);
+}
+
+// a snapshot is not affected by what happens to the heap it was taken from, and the other way around
+void check_snapshot() {
+    PersistentLeftistHeap<std::string, std::greater<>> heap{"b", "d", "a"};
+    std::vector<std::string> words;
+    for (auto i = 0; i < 1000; ++i) words.push_back(std::to_string(get_rand()));
+    heap.push_range(words.begin(), words.end());
+    words.insert(words.end(), {"b", "d", "a"});
+    std::sort(words.begin(), words.end(), std::greater<>());
+    auto snapshot = heap;
+    for (auto i = 0; i < 500; ++i) heap.pop();
+    heap.push("zzz");
+    heap.merge(heap);
+    assert(heap.size() == 1008 && heap.top() == "zzz");
+    heap.pop();
+    heap.pop();
+    assert(heap.top() == words[500]);
+    for (auto &w : words) {
+        assert(snapshot.top() == w);
+        snapshot.pop();
+    }
+    assert(snapshot.empty());
+    snapshot.pop();
+}
+
+// a heap built by pushing decreasing keys is one long left chain, which is freed without recursion
+void check_long_chain() {
+    PersistentLeftistHeap<int> heap;
+    for (auto i = 1000000; i > 0; --i) heap.push(i);
+    auto copy = heap;
+    copy.pop();
+    heap = PersistentLeftistHeap<int>{};
+    assert(copy.top() == 2 && copy.size() == 999999);
+}
+
+int main() {
+    check_versions();
+    check_snapshot();
+    check_long_chain();
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <radix_heap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+// pop the minimum and push keys no smaller than the last popped one at random, as an event simulation does, next to a
+// set of the (key, id) entries; a key may land below or at the current top, also right after top() was called, and
+// pop must remove exactly the entry top returned, whichever of the equal keys that is
+template<class Key>
+void check_hold(Key spread) {
+    using namespace data_structure;
+    RadixHeap<Key, size_t> heap;
+    std::set<std::pair<Key, size_t>> ref;
+    size_t id = 0;
+    Key last = 0;
+    for (auto i = 0; i < 1000; ++i) {
+        auto k = static_cast<Key>(get_rand() % spread);
+        heap.push(k, id);
+        ref.emplace(k, id++);
+    }
+    for (auto round = 0; round < 200000; ++round) {
+        assert(heap.size() == ref.size());
+        if (ref.empty() || get_rand() % 3) {
+            if (!ref.empty() && get_rand() % 2) assert(heap.top().first == ref.begin()->first);
+            auto base = last;
+            auto room = std::numeric_limits<Key>::max() - base;
+            auto k = static_cast<Key>(base + (room ? get_rand() % std::min<Key>(room, spread) : 0));
+            heap.push(k, id);
+            ref.emplace(k, id++);
+        } else {
+            auto t = heap.top();
+            assert(t.first == ref.begin()->first);
+            last = t.first;
+            heap.pop();
+            assert(ref.erase(t) == 1);
+            assert(heap.last_key() == last);
+        }
+    }
+    while (!ref.empty()) {
+        auto t = heap.top();
+        assert(t.first == ref.begin()->first && ref.erase(t) == 1);
+        heap.pop();
+    }
+    assert(heap.empty());
+}
+
+// pops everything, checking the payloads come out once each and the keys in order
+template<class Key>
+void check_drain(data_structure::RadixHeap<Key, int> &heap, std::multiset<std::pair<Key, int>> expected) {
+    Key prev = 0;
+    while (!heap.empty()) {
+        auto t = heap.top();
+        assert(t.first >= prev && expected.count(t) == 1);
+        expected.erase(t);
+        prev = t.first;
+        heap.pop();
+    }
+    assert(expected.empty());
+}
+
+int main() {
+    using namespace data_structure;
+    check_hold<uint8_t>(16);
+    check_hold<uint16_t>(1000);
+    check_hold<uint32_t>(1u << 20u);
+    check_hold<uint64_t>(std::numeric_limits<int>::max());
+    {
+        // values travel with their keys, including across redistributions
+        RadixHeap<uint64_t, std::string> heap;
+        std::vector<uint64_t> keys = {0, 7, 1ull << 40u, 3, 3, 1ull << 63u, 12, 255, 256};
+        for (auto k : keys) heap.emplace(k, std::to_string(k));
+        std::sort(keys.begin(), keys.end());
+        for (auto k : keys) {
+            assert(heap.top().first == k && heap.top().second == std::to_string(k));
+            heap.pop();
+        }
+        assert(heap.empty() && heap.last_key() == 1ull << 63u);
+        heap.push(std::numeric_limits<uint64_t>::max(), "max");
+        assert(heap.top().second == "max");
+        heap.clear();
+        assert(heap.empty() && heap.last_key() == 0);
+    }
+    {
+        // an equal key pushed after top() must not make pop remove another entry than the one top returned
+        RadixHeap<uint32_t, int> heap;
+        heap.push(0, 1);
+        assert(heap.top().second == 1);
+        heap.push(0, 2);
+        heap.pop();
+        assert(heap.size() == 1 && heap.top().second == 2);
+        heap.pop();
+        assert(heap.empty());
+    }
+    {
+        // equal minima redistributed from a higher bucket come out once each
+        RadixHeap<uint32_t, int> heap;
+        heap.push(1, 0);
+        heap.pop();
+        heap.push(6, 1);
+        heap.push(6, 2);
+        heap.push(7, 3);
+        std::vector<int> payloads;
+        for (; !heap.empty(); heap.pop()) payloads.push_back(heap.top().second);
+        std::sort(payloads.begin(), payloads.begin() + 2);
+        assert((payloads == std::vector<int>{1, 2, 3}));
+        heap.push(9, 4);
+        heap.push(9, 5);
+        heap.top();
+        heap.push(9, 6);
+        heap.push(8, 7);
+        heap.top();
+        heap.push(8, 8);
+        check_drain<uint32_t>(heap, {{8, 7}, {8, 8}, {9, 4}, {9, 5}, {9, 6}});
+    }
+    {
+        // top() must not move the base: 7 lies between the last popped key and the top
+        RadixHeap<uint32_t, int> heap;
+        heap.push(5, 0);
+        heap.pop();
+        heap.push(10, 1);
+        assert(heap.top().first == 10 && heap.last_key() == 5);
+        heap.push(7, 2);
+        assert(heap.top().first == 7 && heap.top().second == 2);
+        heap.pop();
+        assert(heap.last_key() == 7 && heap.top().first == 10);
+        heap.push(8, 3);
+        assert(heap.top().first == 8);
+    }
+    return 0;
+}
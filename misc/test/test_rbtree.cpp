@@ -6,6 +6,8 @@
 #include <set>
 #include <iostream>
 #include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace std;
 using namespace data_structure;
@@ -66,4 +68,21 @@ int main() {
         assert(time == test_set.size());
     }
 
+    {
+        // erasing a root with a single child used to leave the freed node as the root
+        for (int n = 1; n < 64; ++n) {
+            RbTree<int> test;
+            vector<int> keys;
+            for (int i = 0; i < n; ++i) {
+                keys.push_back(intGen() % 32);
+                test.insert(keys.back());
+            }
+            shuffle(keys.begin(), keys.end(), mt19937(n));
+            for (auto k : keys) {
+                test.erase(k);
+                assert(!test.contains(k));
+            }
+            assert(test.size() == 0 && test.begin() == test.end());
+        }
+    }
 }
\ No newline at end of file
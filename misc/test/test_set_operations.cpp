@@ -0,0 +1,248 @@
+#include <avl_tree.hpp>
+#include <rb_tree.hpp>
+#include <scapegoat.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+std::mt19937_64 eng{};
+std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+#define get_rand() dist(eng)
+
+using namespace data_structure;
+
+using WeightedTreap = Treap<int, TreapNode<int, WeightedBSTNode<int>>>;
+
+using WeightedAVLTree = AVLTree<int, AVLNode<int, WeightedBSTNode<int>>>;
+
+using WeightedRbTree = RbTree<int, RBTNode<int, WeightedBSTNode<int>>>;
+
+// the trees that may split, as any of them can destroy the nodes of another
+template<class T>
+using TrivialTreap = Treap<T, TreapNode<T>, utils::DefaultCompare<T>, utils::TrivialFactory<TreapNode<T>>>;
+
+template<class T>
+using TrivialAVLTree = AVLTree<T, AVLNode<T>, utils::DefaultCompare<T>, utils::TrivialFactory<AVLNode<T>>>;
+
+template<class T>
+using TrivialRbTree = RbTree<T, RBTNode<T>, utils::DefaultCompare<T>, utils::TrivialFactory<RBTNode<T>>>;
+
+// split, join and the set operations are available on the joinable trees, whatever their factory
+static_assert(Treap<int>::joinable && AVLTree<int>::joinable && RbTree<int>::joinable);
+static_assert(TrivialTreap<int>::joinable && TrivialAVLTree<int>::joinable && TrivialRbTree<int>::joinable);
+static_assert(WeightedTreap::joinable && WeightedAVLTree::joinable && WeightedRbTree::joinable);
+static_assert(!Splay<int>::joinable && !ScapeGoat<int>::joinable && !BSTree<int>::joinable);
+
+// checks the links, the order and the balance of the subtree of u, returning its height, or its black height
+template<class Node>
+int check_node(Node *u, Node *parent, const int *lo, const int *hi) {
+    if (!u) return 0;
+    assert(u->parent == parent);
+    assert((!lo || *lo < u->x) && (!hi || u->x < *hi));
+    auto left = static_cast<Node *>(u->children[LEFT]), right = static_cast<Node *>(u->children[RIGHT]);
+    auto hl = check_node(left, u, lo, &u->x), hr = check_node(right, u, &u->x, hi);
+    if constexpr (std::is_same_v<Node, TreapNode<int>> || std::is_same_v<Node, TreapNode<int, WeightedBSTNode<int>>>) {
+        assert(!left || left->p >= u->p);
+        assert(!right || right->p >= u->p);
+        return 0;
+    } else if constexpr (std::is_same_v<Node, AVLNode<int>> || std::is_same_v<Node, AVLNode<int, WeightedBSTNode<int>>>) {
+        assert(u->delta == hr - hl && u->delta >= -1 && u->delta <= 1);
+        return std::max(hl, hr) + 1;
+    } else {
+        assert(u->color == Color::RED || u->color == Color::BLACK);
+        assert(u->color == Color::BLACK || ((!left || left->color == Color::BLACK) &&
+                                            (!right || right->color == Color::BLACK)));
+        assert(hl == hr);
+        return hl + (u->color == Color::BLACK);
+    }
+}
+
+template<class Tree>
+void check_tree(Tree &tree, const std::set<int> &set) {
+    auto root = tree.top().unsafe_cast();
+    check_node(root, decltype(root){}, nullptr, nullptr);
+    if constexpr (std::is_same_v<Tree, TrivialRbTree<int>> || std::is_same_v<Tree, RbTree<int>>) {
+        assert(!root || root->color == Color::BLACK);
+    }
+    assert(tree.size() == set.size());
+    auto it = tree.begin();
+    for (auto x : set) {
+        assert(it != tree.end() && *it == x);
+        ++it;
+    }
+    assert(it == tree.end());
+}
+
+template<class Tree>
+void fill(Tree &tree, std::set<int> &set, size_t n, int lo, int hi) {
+    for (size_t i = 0; i < n; ++i) {
+        auto x = lo + get_rand() % (hi - lo);
+        tree.insert(x);
+        set.insert(x);
+    }
+}
+
+enum Operation {
+    Union, Intersection, Difference
+};
+
+template<class Tree>
+void check_operation(Operation op, size_t n, size_t m, size_t threads) {
+    Tree a, b;
+    std::set<int> sa, sb, expected;
+    // overlapping ranges of different densities
+    fill(a, sa, n, 0, static_cast<int>(4 * n + 1));
+    fill(b, sb, m, static_cast<int>(n), static_cast<int>(n + 4 * m + 1));
+    auto out = std::inserter(expected, expected.end());
+    switch (op) {
+        case Union:
+            a.unite(b, threads);
+            std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), out);
+            break;
+        case Intersection:
+            a.intersect(b, threads);
+            std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), out);
+            break;
+        case Difference:
+            a.subtract(b, threads);
+            std::set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), out);
+            break;
+    }
+    check_tree(a, expected);
+    assert(b.size() == 0 && b.begin() == b.end());
+    // both trees stay usable
+    for (auto i = 0; i < 200; ++i) {
+        auto x = get_rand() % static_cast<int>(4 * (n + m) + 1);
+        if (get_rand() % 2) assert(a.insert(x) == expected.insert(x).second);
+        else assert(a.erase(x) == (expected.erase(x) == 1));
+    }
+    check_tree(a, expected);
+    std::set<int> sb2;
+    fill(b, sb2, 100, 0, 1000);
+    check_tree(b, sb2);
+}
+
+template<class Tree>
+void check_operations() {
+    for (auto op : {Union, Intersection, Difference}) {
+        for (size_t threads : {1, 2, 3, 8}) {
+            check_operation<Tree>(op, 0, 0, threads);
+            check_operation<Tree>(op, 0, 100, threads);
+            check_operation<Tree>(op, 100, 0, threads);
+            check_operation<Tree>(op, 1, 5000, threads);
+            check_operation<Tree>(op, 5000, 1, threads);
+            check_operation<Tree>(op, 3000, 3000, threads);
+            check_operation<Tree>(op, 20000, 500, threads);
+            check_operation<Tree>(op, 500, 20000, threads);
+        }
+    }
+}
+
+template<class Tree>
+void check_join(size_t n, size_t m) {
+    Tree a, b;
+    std::set<int> sa, sb;
+    fill(a, sa, n, 0, static_cast<int>(2 * n + 1));
+    fill(b, sb, m, static_cast<int>(2 * n + 1), static_cast<int>(2 * n + 2 * m + 2));
+    a.join(b);
+    sa.insert(sb.begin(), sb.end());
+    check_tree(a, sa);
+    assert(b.size() == 0);
+}
+
+template<class Tree>
+void check_split(size_t n) {
+    Tree a, b;
+    std::set<int> sa, sb;
+    fill(a, sa, n, 0, static_cast<int>(2 * n + 1));
+    for (auto i = 0; i < 20; ++i) {
+        auto x = get_rand() % static_cast<int>(2 * n + 3) - 1;
+        a.split(x, b);
+        sb.clear();
+        sb.insert(sa.lower_bound(x), sa.end());
+        sa.erase(sa.lower_bound(x), sa.end());
+        check_tree(a, sa);
+        check_tree(b, sb);
+        // sizes are counted again, and keep up with later updates
+        a.insert(x - 1);
+        sa.insert(x - 1);
+        a.erase(x - 2);
+        sa.erase(x - 2);
+        b.insert(x);
+        sb.insert(x);
+        assert(a.size() == sa.size() && b.size() == sb.size());
+        check_tree(a, sa);
+        a.join(b);
+        sa.insert(sb.begin(), sb.end());
+        check_tree(a, sa);
+    }
+}
+
+// the part split off outlives the tree it came from, even when their factories own the nodes
+template<class Tree>
+void check_split_lifetime() {
+    Tree right;
+    std::set<int> sa, sr;
+    {
+        Tree left;
+        fill(left, sa, 3000, 0, 6000);
+        left.split(3000, right);
+        sr.insert(sa.lower_bound(3000), sa.end());
+        sa.erase(sa.lower_bound(3000), sa.end());
+        check_tree(left, sa);
+    }
+    check_tree(right, sr);
+    for (auto i = 0; i < 1000; ++i) {
+        auto x = get_rand() % 6000;
+        assert(right.insert(x) == sr.insert(x).second);
+    }
+    check_tree(right, sr);
+}
+
+template<class Tree>
+void check_weights() {
+    Tree a, b;
+    std::set<int> sa, sb, expected;
+    fill(a, sa, 5000, 0, 20000);
+    fill(b, sb, 5000, 10000, 30000);
+    a.unite(b, 4);
+    std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), std::inserter(expected, expected.end()));
+    size_t k = 0;
+    for (auto x : expected) {
+        assert(a.rank(x) == k && *a.select(k) == x);
+        ++k;
+    }
+}
+
+int main() {
+    check_operations<Treap<int>>();
+    check_operations<AVLTree<int>>();
+    check_operations<RbTree<int>>();
+    check_operations<TrivialRbTree<int>>();
+    for (auto [n, m] : {std::pair<size_t, size_t>{0, 0}, {0, 1000}, {1000, 0}, {1, 3000}, {3000, 1}, {2000, 2000}}) {
+        check_join<Treap<int>>(n, m);
+        check_join<AVLTree<int>>(n, m);
+        check_join<RbTree<int>>(n, m);
+    }
+    check_split<TrivialTreap<int>>(3000);
+    check_split<TrivialAVLTree<int>>(3000);
+    check_split<TrivialRbTree<int>>(3000);
+    check_split<TrivialRbTree<int>>(1);
+    check_split<Treap<int>>(3000);
+    check_split<AVLTree<int>>(3000);
+    check_split<RbTree<int>>(3000);
+    check_split_lifetime<Treap<int>>();
+    check_split_lifetime<AVLTree<int>>();
+    check_split_lifetime<RbTree<int>>();
+    check_split_lifetime<TrivialTreap<int>>();
+    check_weights<WeightedTreap>();
+    check_weights<WeightedAVLTree>();
+    check_weights<WeightedRbTree>();
+    return 0;
+}
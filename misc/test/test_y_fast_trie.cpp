@@ -200,5 +200,21 @@ int main() {
         }
     }
 
+    {
+        YFastTrie<int> test;
+        assert(!test.contains(1));
+        assert(!test.pred(1));
+        assert(!test.succ(1));
+        test.erase(1);
+        for (int round = 0; round < 2; ++round) {
+            for (int i = 0; i < 100; ++i) test.insert(i);
+            for (int i = 0; i < 100; ++i) test.erase(i);
+            assert(!test.contains(50));
+            assert(!test.succ(50));
+        }
+        test.insert(7);
+        assert(test.contains(7) && test.succ(0) == 7 && test.pred(10) == 7);
+    }
+
     return 0;
 }
\ No newline at end of file
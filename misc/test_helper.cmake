@@ -1,10 +1,16 @@
+# Unit tests check themselves with assert, so NDEBUG is always dropped for them.
+# Coverage instrumentation is only added in the Coverage profile.
+set(TEST_COVERAGE_FLAGS "$<$<CONFIG:Coverage>:-fprofile-arcs;-ftest-coverage>")
+
 function(unit_test name)
     add_executable(test_${name} misc/test/test_${name}.cpp)
+    target_link_libraries(test_${name} data_structure_for_love)
+    target_compile_options(test_${name} PRIVATE -UNDEBUG "$<$<CONFIG:Coverage>:-O0;-g>" "${TEST_COVERAGE_FLAGS}")
+    target_link_libraries(test_${name} "${TEST_COVERAGE_FLAGS}")
     add_test(test_${name}_run test_${name})
 endfunction()
 
 function(unit_test_with_lib name lib)
-    add_executable(test_${name} misc/test/test_${name}.cpp)
+    unit_test(${name})
     target_link_libraries(test_${name} ${lib})
-    add_test(test_${name}_run test_${name})
-endfunction()
\ No newline at end of file
+endfunction()
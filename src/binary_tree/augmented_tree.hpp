@@ -0,0 +1,240 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_AUGMENTED_TREE_HPP
+#define DATA_STRUCTURE_FOR_LOVE_AUGMENTED_TREE_HPP
+
+#include <avl_tree.hpp>
+#include <rb_tree.hpp>
+#include <splay.hpp>
+#include <treap.hpp>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace data_structure {
+    template<class T>
+    struct SumMonoid {
+        using value_type = T;
+
+        static value_type identity() { return T{}; }
+
+        static value_type lift(const T &x) { return x; }
+
+        static value_type combine(const value_type &a, const value_type &b) { return a + b; }
+    };
+
+    template<class T>
+    struct MinMonoid {
+        using value_type = T;
+
+        static value_type identity() { return std::numeric_limits<T>::max(); }
+
+        static value_type lift(const T &x) { return x; }
+
+        static value_type combine(const value_type &a, const value_type &b) { return std::min(a, b); }
+    };
+
+    template<class T>
+    struct MaxMonoid {
+        using value_type = T;
+
+        static value_type identity() { return std::numeric_limits<T>::lowest(); }
+
+        static value_type lift(const T &x) { return x; }
+
+        static value_type combine(const value_type &a, const value_type &b) { return std::max(a, b); }
+    };
+
+    template<class T>
+    struct CountMonoid {
+        using value_type = size_t;
+
+        static value_type identity() { return 0; }
+
+        static value_type lift(const T &) { return 1; }
+
+        static value_type combine(const value_type &a, const value_type &b) { return a + b; }
+    };
+
+    /*
+     * The balanced trees with Base as the node they extend, e.g. AugmentedBSTNode<T, SumMonoid<T>>, as template
+     * template arguments of IntervalTree and AggregateMap.
+     */
+    template<class T, class Base, class Compare>
+    using AugmentedRbTree = RbTree<T, RBTNode<T, Base>, Compare>;
+
+    template<class T, class Base, class Compare>
+    using AugmentedAVLTree = AVLTree<T, AVLNode<T, Base>, Compare>;
+
+    template<class T, class Base, class Compare>
+    using AugmentedTreap = Treap<T, TreapNode<T, Base>, Compare>;
+
+    template<class T, class Base, class Compare>
+    using AugmentedSplay = Splay<T, Base, Compare>;
+
+    template<class T>
+    struct Interval {
+        T lo, hi;
+    };
+
+    /*
+     * Closed intervals [lo, hi] ordered by lo then hi, every node keeping the largest hi of its subtree. A subtree
+     * whose largest hi is below the query, or whose smallest lo is past it, holds no overlap, so finding one overlap
+     * takes O(log n) and reporting all k of them O(k log n). Equal intervals are stored once.
+     */
+    template<class T, template<class, class, class> class Tree = AugmentedRbTree>
+    class IntervalTree {
+        struct Order {
+            constexpr utils::Relation operator()(const Interval<T> &a, const Interval<T> &b) const noexcept {
+                if (a.lo < b.lo) return utils::Less;
+                if (b.lo < a.lo) return utils::Greater;
+                if (a.hi < b.hi) return utils::Less;
+                if (b.hi < a.hi) return utils::Greater;
+                return utils::Eq;
+            }
+        };
+
+        struct MaxEnd {
+            using value_type = T;
+
+            static value_type identity() { return std::numeric_limits<T>::lowest(); }
+
+            static value_type lift(const Interval<T> &x) { return x.hi; }
+
+            static value_type combine(const value_type &a, const value_type &b) { return std::max(a, b); }
+        };
+
+        using Base = Tree<Interval<T>, AugmentedBSTNode<Interval<T>, MaxEnd>, Order>;
+        using Node = std::remove_pointer_t<decltype(std::declval<typename Base::walker>().unsafe_cast())>;
+
+        Base tree;
+
+        static Node *child(Node *u, Direction d) { return static_cast<Node *>(u->children[d]); }
+
+        template<class F>
+        static void collect(Node *u, const T &lo, const T &hi, F &f);
+
+    public:
+        bool insert(const T &lo, const T &hi) { return tree.insert({lo, hi}); }
+
+        bool erase(const T &lo, const T &hi) { return tree.erase({lo, hi}); }
+
+        bool contains(const T &lo, const T &hi) { return tree.contains({lo, hi}); }
+
+        size_t size() { return tree.size(); }
+
+        void clear() { tree.clear(); }
+
+        // whether any interval shares a point with [lo, hi]
+        bool overlaps(const T &lo, const T &hi);
+
+        // the intervals sharing a point with [lo, hi], in order
+        std::vector<Interval<T>> overlapping(const T &lo, const T &hi);
+
+        // the intervals containing x, in order
+        std::vector<Interval<T>> stab(const T &x) { return overlapping(x, x); }
+
+        typename Base::iterator begin() { return tree.begin(); }
+
+        typename Base::iterator end() { return tree.end(); }
+    };
+
+    template<class T, template<class, class, class> class Tree>
+    bool IntervalTree<T, Tree>::overlaps(const T &lo, const T &hi) {
+        auto u = tree.top().unsafe_cast();
+        while (u) {
+            if (!(hi < u->x.lo) && !(u->x.hi < lo)) return true;
+            // the left subtree has the smaller starts, so it holds an overlap whenever one of its ends reaches lo
+            auto left = child(u, LEFT);
+            u = left && !(left->summary < lo) ? left : child(u, RIGHT);
+        }
+        return false;
+    }
+
+    template<class T, template<class, class, class> class Tree>
+    template<class F>
+    void IntervalTree<T, Tree>::collect(Node *u, const T &lo, const T &hi, F &f) {
+        while (u && !(u->summary < lo)) {
+            collect(child(u, LEFT), lo, hi, f);
+            if (hi < u->x.lo) return;
+            if (!(u->x.hi < lo)) f(u->x);
+            u = child(u, RIGHT);
+        }
+    }
+
+    template<class T, template<class, class, class> class Tree>
+    std::vector<Interval<T>> IntervalTree<T, Tree>::overlapping(const T &lo, const T &hi) {
+        std::vector<Interval<T>> res;
+        auto push = [&](const Interval<T> &x) { res.push_back(x); };
+        collect(tree.top().unsafe_cast(), lo, hi, push);
+        return res;
+    }
+
+    /*
+     * An ordered map from K to V answering Monoid::combine of the values of a key range, in key order, in O(log n).
+     * Values can be overwritten in place, refreshing the summaries up to the root. Keys are looked up through pairs
+     * with a default constructed V, so V must be default constructible.
+     */
+    template<class K, class V, class Monoid = SumMonoid<V>, template<class, class, class> class Tree = AugmentedRbTree,
+            class Compare = utils::DefaultCompare<K>>
+    class AggregateMap {
+        struct Order {
+            constexpr utils::Relation operator()(const std::pair<K, V> &a, const std::pair<K, V> &b) const noexcept {
+                return Compare{}(a.first, b.first);
+            }
+        };
+
+        struct Values {
+            using value_type = typename Monoid::value_type;
+
+            static value_type identity() { return Monoid::identity(); }
+
+            static value_type lift(const std::pair<K, V> &x) { return Monoid::lift(x.second); }
+
+            static value_type combine(const value_type &a, const value_type &b) { return Monoid::combine(a, b); }
+        };
+
+        using Base = Tree<std::pair<K, V>, AugmentedBSTNode<std::pair<K, V>, Values>, Order>;
+        using Node = std::remove_pointer_t<decltype(std::declval<typename Base::walker>().unsafe_cast())>;
+
+        Base tree;
+
+    public:
+        using walker = typename Base::walker;
+
+        // false if the key is present, which keeps its value
+        bool insert(const K &k, const V &v) { return tree.insert({k, v}); }
+
+        // inserts the key or overwrites its value
+        void assign(const K &k, const V &v);
+
+        bool erase(const K &k) { return tree.erase({k, V{}}); }
+
+        // a walker to the (key, value) pair, invalid if the key is absent
+        walker find(const K &k) { return tree.find({k, V{}}); }
+
+        bool contains(const K &k) { return tree.contains({k, V{}}); }
+
+        size_t size() { return tree.size(); }
+
+        void clear() { tree.clear(); }
+
+        // Monoid::combine of the values with keys in [lo, hi]
+        typename Monoid::value_type aggregate(const K &lo, const K &hi) { return tree.fold({lo, V{}}, {hi, V{}}); }
+
+        typename Base::iterator begin() { return tree.begin(); }
+
+        typename Base::iterator end() { return tree.end(); }
+    };
+
+    template<class K, class V, class Monoid, template<class, class, class> class Tree, class Compare>
+    void AggregateMap<K, V, Monoid, Tree, Compare>::assign(const K &k, const V &v) {
+        auto w = tree.find({k, V{}});
+        if (!w.valid()) {
+            tree.insert({k, v});
+            return;
+        }
+        w->second = v;
+        for (Node *u = w.unsafe_cast(); u; u = static_cast<Node *>(u->parent)) u->update();
+    }
+}
+#endif //DATA_STRUCTURE_FOR_LOVE_AUGMENTED_TREE_HPP
@@ -6,23 +6,27 @@
 #define DATA_STRUCTURE_FOR_LOVE_AVL_TREE_HPP
 
 #include <binary_tree_base.hpp>
+#include <algorithm>
 
 namespace data_structure {
-    template<class T>
-    struct AVLNode : public BSTNode<T> {
+    // Base is BSTNode, or an augmented node such as WeightedBSTNode
+    template<class T, class Base = BSTNode<T>>
+    struct AVLNode : public Base {
         int delta;
 
         template<typename ...Args>
-        explicit AVLNode(Args &&...args) : BSTNode<T>(std::forward<Args>(args)...), delta(0) {}
+        explicit AVLNode(Args &&...args) : Base(std::forward<Args>(args)...), delta(0) {}
     };
 
     template<class T, class Node = AVLNode<T>,
             class Compare = utils::DefaultCompare<T>, class Factory = utils::PoolFactory<Node>>
-    class AVLTree : public BSTree<T, Node, Compare, Factory> {
+    class AVLTree : public BSTree<T, Node, Compare, Factory, AVLTree<T, Node, Compare, Factory>> {
     protected:
+        using Base = BSTree<T, Node, Compare, Factory, AVLTree>;
+        friend Base; // split and the set operations of the base join through join_node
         using BinTree<Node, Factory>::factory;
-        using BSTree<T, Node, Compare, Factory>::compare;
-        using BSTree<T, Node, Compare, Factory>::n;
+        using Base::compare;
+        using Base::n;
 
         Node *left_rotate(Node *t, Node *x);
 
@@ -40,11 +44,24 @@ namespace data_structure {
             return x && x->children[LEFT] == nullptr && x->children[RIGHT] == nullptr;
         }
 
+        // walks down the taller side, as the nodes keep balance factors rather than heights
+        static int height(Node *t);
+
+        // rebalances p, whose delta is 2 or -2 after its subtree on that side grew; returns whether p's subtree
+        // still is one level taller than before the growth, its new top going to top
+        bool rebalance(Node *&t, Node *p, Node *&top);
+
+        // links m between l and r: m replaces the first node on the facing spine of the taller tree that is at most
+        // one level taller than the other tree, and the growth goes up like an insertion; O(log n) with the heights
+        Node *join_node(Node *l, Node *m, Node *r);
+
     public:
+        constexpr static bool joinable = true;
 
-        bool insert(const T &x) override;
 
-        bool erase(const T &x) override;
+        bool insert(const T &x);
+
+        bool erase(const T &x);
 
     };
 
@@ -237,11 +254,86 @@ namespace data_structure {
             x = y;
             y = static_cast<Node *>(y->replace_with(static_cast<Node *>(y->children[RIGHT])));
         }
+        this->bottom_up_update(parent);
         t = delete_fix(t, parent, y);
         factory.destroy(x);
         return t;
     }
 
+    template<class T, class Node, class Compare, class Factory>
+    int AVLTree<T, Node, Compare, Factory>::height(Node *t) {
+        int h = 0;
+        for (; t; ++h) t = static_cast<Node *>(t->children[t->delta < 0 ? LEFT : RIGHT]);
+        return h;
+    }
+
+    template<class T, class Node, class Compare, class Factory>
+    bool AVLTree<T, Node, Compare, Factory>::rebalance(Node *&t, Node *p, Node *&top) {
+        auto d = p->delta > 0 ? RIGHT : LEFT;
+        auto sign = d == RIGHT ? 1 : -1;
+        auto c = static_cast<Node *>(p->children[d]);
+        if (c->delta * sign >= 0) {
+            // single rotation; a balanced child leaves the height as it is
+            auto grown = c->delta == 0;
+            p->delta = grown ? sign : 0;
+            c->delta = grown ? -sign : 0;
+            t = d == RIGHT ? left_rotate(t, p) : right_rotate(t, p);
+            top = c;
+            return grown;
+        }
+        auto g = static_cast<Node *>(c->children[!d]);
+        p->delta = g->delta == sign ? -sign : 0;
+        c->delta = g->delta == -sign ? sign : 0;
+        g->delta = 0;
+        if (d == RIGHT) {
+            t = right_rotate(t, c);
+            t = left_rotate(t, p);
+        } else {
+            t = left_rotate(t, c);
+            t = right_rotate(t, p);
+        }
+        top = g;
+        return false;
+    }
+
+    template<class T, class Node, class Compare, class Factory>
+    Node *AVLTree<T, Node, Compare, Factory>::join_node(Node *l, Node *m, Node *r) {
+        auto hl = height(l), hr = height(r);
+        if (hl <= hr + 1 && hr <= hl + 1) {
+            m->set_children(l, r);
+            m->delta = hr - hl;
+            m->update();
+            return m;
+        }
+        auto d = hl > hr ? RIGHT : LEFT;
+        auto sign = d == RIGHT ? 1 : -1;
+        Node *t = d == RIGHT ? l : r, *s = d == RIGHT ? r : l, *c = t, *p = nullptr;
+        auto hs = std::min(hl, hr), hc = std::max(hl, hr);
+        while (hc > hs + 1) {
+            // the child facing s is one level shorter, or two if c leans the other way
+            hc -= c->delta * sign < 0 ? 2 : 1;
+            p = c;
+            c = static_cast<Node *>(c->children[d]);
+        }
+        if (d == RIGHT) m->set_children(c, s);
+        else m->set_children(s, c);
+        m->delta = (hs - hc) * sign;
+        p->children[d] = m;
+        m->parent = p;
+        m->update();
+        this->bottom_up_update(p);
+        // m is one level taller than c was
+        Node *x = m;
+        while (p) {
+            p->delta += x == p->children[RIGHT] ? 1 : -1;
+            if (p->delta == 0) break;
+            if (p->delta == 1 || p->delta == -1) x = p;
+            else if (!rebalance(t, p, x)) break;
+            p = static_cast<Node *>(x->parent);
+        }
+        return t;
+    }
+
     template<class T, class Node, class Compare, class Factory>
     bool AVLTree<T, Node, Compare, Factory>::insert(const T &x) {
         auto new_root = insert(this->root, x);
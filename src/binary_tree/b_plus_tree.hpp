@@ -0,0 +1,543 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_B_PLUS_TREE_HPP
+#define DATA_STRUCTURE_FOR_LOVE_B_PLUS_TREE_HPP
+
+#include <compare.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace data_structure {
+    /*
+     * B+ tree. Every element lives in a leaf, the leaves are linked both ways for scans, and an inner node only keeps
+     * separators: the elements under children[i] are less than keys[i], those under children[i + 1] are not.
+     * A node spans `Lines` cache lines and holds as many keys as fit, so a lookup visits about log_B(n) nodes instead
+     * of the log_2(n) of a binary tree, reading whole lines each time. Arithmetic keys in their natural order are
+     * searched in a node by counting the smaller keys without branches, a loop the compiler vectorizes; other keys are
+     * binary searched with Compare.
+     * Nodes keep their keys in plain arrays, so T must be default constructible and copy assignable.
+     */
+    template<class T, class Compare = utils::DefaultCompare<T>, std::size_t Lines = 4>
+    class BPlusTree {
+        constexpr static std::size_t cache_line = 64;
+        constexpr static std::size_t node_bytes = Lines * cache_line;
+
+    public:
+        // a leaf keeps its size and two links besides the keys, an inner node its size and one more child than keys
+        constexpr static std::size_t leaf_capacity =
+                std::max<std::size_t>(3, (node_bytes - sizeof(std::size_t) - 2 * sizeof(void *)) / sizeof(T));
+        constexpr static std::size_t inner_capacity =
+                std::max<std::size_t>(3, (node_bytes - sizeof(std::size_t) - sizeof(void *)) /
+                                         (sizeof(T) + sizeof(void *)));
+
+    private:
+        constexpr static std::size_t leaf_min = leaf_capacity / 2;
+        constexpr static std::size_t inner_min = inner_capacity / 2;
+
+        struct alignas(cache_line) Leaf {
+            std::size_t count = 0;
+            Leaf *prev = nullptr, *next = nullptr;
+            T keys[leaf_capacity];
+        };
+
+        // the children are leaves or inner nodes depending on the level, which the tree keeps track of
+        struct alignas(cache_line) Inner {
+            std::size_t count = 0;
+            void *children[inner_capacity + 1];
+            T keys[inner_capacity];
+        };
+
+        constexpr static Compare compare{};
+        constexpr static bool branchless = std::is_arithmetic_v<T> && std::is_same_v<Compare, utils::DefaultCompare<T>>;
+
+        void *root = nullptr;
+        Leaf *head = nullptr, *tail = nullptr;
+        std::size_t height = 0; // levels of inner nodes
+        std::size_t n = 0;
+
+        // number of keys less than x, or not greater than x without Strict
+        template<bool Strict>
+        static std::size_t rank(const T *keys, std::size_t count, const T &x) noexcept;
+
+        static void insert_at(T *keys, std::size_t count, std::size_t i, const T &x);
+
+        bool insert(void *u, std::size_t level, const T &x, T &separator, void *&split);
+
+        bool erase(void *u, std::size_t level, const T &x);
+
+        // refills children[i] of parent, at the given level, from a sibling when it has fallen below half
+        void rebalance(Inner *parent, std::size_t i, std::size_t level);
+
+        // merges children[i + 1] of parent into children[i]
+        void merge_leaves(Inner *parent, std::size_t i);
+
+        void merge_inners(Inner *parent, std::size_t i);
+
+        static void remove_separator(Inner *parent, std::size_t i);
+
+        // the leaf x belongs to, choosing among equal separators the way rank<Strict> does
+        template<bool Strict>
+        Leaf *descend(const T &x) const noexcept;
+
+        static void release(void *u, std::size_t level);
+
+    public:
+        class walker;
+
+        class iterator;
+
+        BPlusTree() = default;
+
+        BPlusTree(const BPlusTree &) = delete;
+
+        BPlusTree &operator=(const BPlusTree &) = delete;
+
+        BPlusTree(BPlusTree &&that) noexcept;
+
+        BPlusTree &operator=(BPlusTree &&that) noexcept;
+
+        ~BPlusTree();
+
+        bool insert(const T &x);
+
+        bool erase(const T &x);
+
+        walker find(const T &x);
+
+        size_t size();
+
+        void clear();
+
+        walker min();
+
+        walker max();
+
+        // the largest element less than x
+        walker pred(const T &x);
+
+        // the smallest element greater than x
+        walker succ(const T &x);
+
+        bool contains(const T &x);
+
+        iterator begin();
+
+        iterator end();
+    };
+
+    template<class T, class Compare, std::size_t Lines>
+    class BPlusTree<T, Compare, Lines>::walker {
+        Leaf *leaf;
+        std::size_t i;
+    public:
+        explicit walker(Leaf *leaf, std::size_t i = 0) : leaf(leaf), i(i) {}
+
+        T &get() { return leaf->keys[i]; }
+
+        const T &get() const { return leaf->keys[i]; }
+
+        T &operator*() { return get(); }
+
+        const T &operator*() const { return get(); }
+
+        T *operator->() { return &get(); }
+
+        const T *operator->() const { return &get(); }
+
+        void go_succ() {
+            if (++i == leaf->count) {
+                leaf = leaf->next;
+                i = 0;
+            }
+        }
+
+        void go_pred() {
+            if (i) --i;
+            else if ((leaf = leaf->prev)) i = leaf->count - 1;
+        }
+
+        bool valid() { return leaf; }
+
+        bool operator==(const walker &that) const { return leaf == that.leaf && i == that.i; }
+
+        bool operator!=(const walker &that) const { return !(*this == that); }
+    };
+
+    template<class T, class Compare, std::size_t Lines>
+    class BPlusTree<T, Compare, Lines>::iterator {
+        walker w;
+        BPlusTree *tree;
+    public:
+        explicit iterator(walker w, BPlusTree *tree) : w(w), tree(tree) {}
+
+        bool operator==(const iterator &that) { return w == that.w; }
+
+        bool operator!=(const iterator &that) { return w != that.w; }
+
+        T &operator*() { return *w; }
+
+        const T &operator*() const { return *w; }
+
+        T *operator->() { return &*w; }
+
+        const T *operator->() const { return &*w; }
+
+        iterator &operator++() {
+            w.go_succ();
+            return *this;
+        }
+
+        const iterator operator++(int) {
+            auto m = *this;
+            w.go_succ();
+            return m;
+        }
+
+        iterator &operator--() {
+            if (!w.valid()) w = tree->max();
+            else w.go_pred();
+            return *this;
+        }
+
+        const iterator operator--(int) {
+            auto m = *this;
+            --*this;
+            return m;
+        }
+    };
+
+    template<class T, class Compare, std::size_t Lines>
+    template<bool Strict>
+    std::size_t BPlusTree<T, Compare, Lines>::rank(const T *keys, std::size_t count, const T &x) noexcept {
+        if constexpr (branchless) {
+            std::size_t r = 0;
+            for (std::size_t i = 0; i < count; ++i) r += Strict ? keys[i] < x : !(x < keys[i]);
+            return r;
+        } else {
+            std::size_t lo = 0, hi = count;
+            while (lo < hi) {
+                auto mid = (lo + hi) / 2;
+                auto relation = compare(keys[mid], x);
+                if (relation == utils::Less || (!Strict && relation == utils::Eq)) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo;
+        }
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::insert_at(T *keys, std::size_t count, std::size_t i, const T &x) {
+        std::move_backward(keys + i, keys + count, keys + count + 1);
+        keys[i] = x;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    bool BPlusTree<T, Compare, Lines>::insert(void *u, std::size_t level, const T &x, T &separator, void *&split) {
+        if (!level) {
+            auto leaf = static_cast<Leaf *>(u);
+            auto i = rank<true>(leaf->keys, leaf->count, x);
+            if (i < leaf->count && compare(leaf->keys[i], x) == utils::Eq) return false;
+            if (leaf->count < leaf_capacity) {
+                insert_at(leaf->keys, leaf->count++, i, x);
+                return true;
+            }
+            // the capacity + 1 keys are shared out, the left leaf keeping `half` of them
+            auto right = new Leaf;
+            constexpr auto half = (leaf_capacity + 1) / 2;
+            if (i < half) {
+                std::move(leaf->keys + half - 1, leaf->keys + leaf_capacity, right->keys);
+                right->count = leaf_capacity - half + 1;
+                leaf->count = half - 1;
+                insert_at(leaf->keys, leaf->count++, i, x);
+            } else {
+                std::move(leaf->keys + half, leaf->keys + leaf_capacity, right->keys);
+                right->count = leaf_capacity - half;
+                leaf->count = half;
+                insert_at(right->keys, right->count++, i - half, x);
+            }
+            right->prev = leaf;
+            right->next = leaf->next;
+            if (right->next) right->next->prev = right;
+            else tail = right;
+            leaf->next = right;
+            separator = right->keys[0];
+            split = right;
+            return true;
+        }
+        auto node = static_cast<Inner *>(u);
+        auto i = rank<false>(node->keys, node->count, x);
+        T child_separator;
+        void *child = nullptr;
+        if (!insert(node->children[i], level - 1, x, child_separator, child)) return false;
+        if (!child) return true;
+        if (node->count < inner_capacity) {
+            insert_at(node->keys, node->count, i, child_separator);
+            std::move_backward(node->children + i + 1, node->children + node->count + 1,
+                               node->children + node->count + 2);
+            node->children[i + 1] = child;
+            node->count++;
+            return true;
+        }
+        // capacity + 1 keys: the middle one moves up, those left of it stay and those right of it leave
+        T keys[inner_capacity + 1];
+        void *children[inner_capacity + 2];
+        std::move(node->keys, node->keys + inner_capacity, keys);
+        std::copy(node->children, node->children + inner_capacity + 1, children);
+        insert_at(keys, inner_capacity, i, child_separator);
+        std::copy_backward(children + i + 1, children + inner_capacity + 1, children + inner_capacity + 2);
+        children[i + 1] = child;
+        constexpr auto mid = (inner_capacity + 1) / 2;
+        auto right = new Inner;
+        std::move(keys, keys + mid, node->keys);
+        std::copy(children, children + mid + 1, node->children);
+        node->count = mid;
+        std::move(keys + mid + 1, keys + inner_capacity + 1, right->keys);
+        std::copy(children + mid + 1, children + inner_capacity + 2, right->children);
+        right->count = inner_capacity - mid;
+        separator = std::move(keys[mid]);
+        split = right;
+        return true;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    bool BPlusTree<T, Compare, Lines>::erase(void *u, std::size_t level, const T &x) {
+        if (!level) {
+            auto leaf = static_cast<Leaf *>(u);
+            auto i = rank<true>(leaf->keys, leaf->count, x);
+            if (i == leaf->count || compare(leaf->keys[i], x) != utils::Eq) return false;
+            std::move(leaf->keys + i + 1, leaf->keys + leaf->count, leaf->keys + i);
+            leaf->count--;
+            return true;
+        }
+        auto node = static_cast<Inner *>(u);
+        auto i = rank<false>(node->keys, node->count, x);
+        if (!erase(node->children[i], level - 1, x)) return false;
+        rebalance(node, i, level - 1);
+        return true;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::rebalance(Inner *parent, std::size_t i, std::size_t level) {
+        if (!level) {
+            auto leaf = static_cast<Leaf *>(parent->children[i]);
+            if (leaf->count >= leaf_min) return;
+            if (i > 0 && static_cast<Leaf *>(parent->children[i - 1])->count > leaf_min) {
+                auto left = static_cast<Leaf *>(parent->children[i - 1]);
+                insert_at(leaf->keys, leaf->count++, 0, left->keys[--left->count]);
+                parent->keys[i - 1] = leaf->keys[0];
+            } else if (i < parent->count && static_cast<Leaf *>(parent->children[i + 1])->count > leaf_min) {
+                auto right = static_cast<Leaf *>(parent->children[i + 1]);
+                leaf->keys[leaf->count++] = std::move(right->keys[0]);
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                right->count--;
+                parent->keys[i] = right->keys[0];
+            } else {
+                merge_leaves(parent, i > 0 ? i - 1 : i);
+            }
+            return;
+        }
+        auto node = static_cast<Inner *>(parent->children[i]);
+        if (node->count >= inner_min) return;
+        if (i > 0 && static_cast<Inner *>(parent->children[i - 1])->count > inner_min) {
+            // the separator comes down in front of node and the last key of the left sibling takes its place
+            auto left = static_cast<Inner *>(parent->children[i - 1]);
+            insert_at(node->keys, node->count, 0, parent->keys[i - 1]);
+            std::copy_backward(node->children, node->children + node->count + 1, node->children + node->count + 2);
+            node->children[0] = left->children[left->count];
+            node->count++;
+            parent->keys[i - 1] = std::move(left->keys[--left->count]);
+        } else if (i < parent->count && static_cast<Inner *>(parent->children[i + 1])->count > inner_min) {
+            auto right = static_cast<Inner *>(parent->children[i + 1]);
+            node->keys[node->count] = std::move(parent->keys[i]);
+            node->children[++node->count] = right->children[0];
+            parent->keys[i] = std::move(right->keys[0]);
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            std::copy(right->children + 1, right->children + right->count + 1, right->children);
+            right->count--;
+        } else {
+            merge_inners(parent, i > 0 ? i - 1 : i);
+        }
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::remove_separator(Inner *parent, std::size_t i) {
+        std::move(parent->keys + i + 1, parent->keys + parent->count, parent->keys + i);
+        std::copy(parent->children + i + 2, parent->children + parent->count + 1, parent->children + i + 1);
+        parent->count--;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::merge_leaves(Inner *parent, std::size_t i) {
+        auto left = static_cast<Leaf *>(parent->children[i]), right = static_cast<Leaf *>(parent->children[i + 1]);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count);
+        left->count += right->count;
+        left->next = right->next;
+        if (left->next) left->next->prev = left;
+        else tail = left;
+        delete right;
+        remove_separator(parent, i);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::merge_inners(Inner *parent, std::size_t i) {
+        auto left = static_cast<Inner *>(parent->children[i]), right = static_cast<Inner *>(parent->children[i + 1]);
+        left->keys[left->count] = std::move(parent->keys[i]);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        delete right;
+        remove_separator(parent, i);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    template<bool Strict>
+    typename BPlusTree<T, Compare, Lines>::Leaf *BPlusTree<T, Compare, Lines>::descend(const T &x) const noexcept {
+        auto u = root;
+        for (auto level = height; level; --level) {
+            auto node = static_cast<Inner *>(u);
+            u = node->children[rank<Strict>(node->keys, node->count, x)];
+        }
+        return static_cast<Leaf *>(u);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::release(void *u, std::size_t level) {
+        if (!level) {
+            delete static_cast<Leaf *>(u);
+            return;
+        }
+        auto node = static_cast<Inner *>(u);
+        for (std::size_t i = 0; i <= node->count; ++i) release(node->children[i], level - 1);
+        delete node;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    BPlusTree<T, Compare, Lines>::BPlusTree(BPlusTree &&that) noexcept
+            : root(that.root), head(that.head), tail(that.tail), height(that.height), n(that.n) {
+        that.root = that.head = that.tail = nullptr;
+        that.height = that.n = 0;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    BPlusTree<T, Compare, Lines> &BPlusTree<T, Compare, Lines>::operator=(BPlusTree &&that) noexcept {
+        std::swap(root, that.root);
+        std::swap(head, that.head);
+        std::swap(tail, that.tail);
+        std::swap(height, that.height);
+        std::swap(n, that.n);
+        return *this;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    BPlusTree<T, Compare, Lines>::~BPlusTree() {
+        clear();
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    bool BPlusTree<T, Compare, Lines>::insert(const T &x) {
+        if (!root) {
+            head = tail = new Leaf;
+            head->keys[0] = x;
+            head->count = 1;
+            root = head;
+            n = 1;
+            return true;
+        }
+        T separator;
+        void *split = nullptr;
+        if (!insert(root, height, x, separator, split)) return false;
+        if (split) {
+            auto node = new Inner;
+            node->keys[0] = std::move(separator);
+            node->children[0] = root;
+            node->children[1] = split;
+            node->count = 1;
+            root = node;
+            height++;
+        }
+        n++;
+        return true;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    bool BPlusTree<T, Compare, Lines>::erase(const T &x) {
+        if (!root || !erase(root, height, x)) return false;
+        n--;
+        if (height && !static_cast<Inner *>(root)->count) {
+            auto old = static_cast<Inner *>(root);
+            root = old->children[0];
+            delete old;
+            height--;
+        } else if (!height && !static_cast<Leaf *>(root)->count) {
+            delete static_cast<Leaf *>(root);
+            root = head = tail = nullptr;
+        }
+        return true;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::walker BPlusTree<T, Compare, Lines>::find(const T &x) {
+        if (!root) return walker(nullptr);
+        auto leaf = descend<false>(x);
+        auto i = rank<true>(leaf->keys, leaf->count, x);
+        if (i < leaf->count && compare(leaf->keys[i], x) == utils::Eq) return walker(leaf, i);
+        return walker(nullptr);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    size_t BPlusTree<T, Compare, Lines>::size() {
+        return n;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    void BPlusTree<T, Compare, Lines>::clear() {
+        if (root) release(root, height);
+        root = head = tail = nullptr;
+        height = n = 0;
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::walker BPlusTree<T, Compare, Lines>::min() {
+        return walker(head);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::walker BPlusTree<T, Compare, Lines>::max() {
+        return tail ? walker(tail, tail->count - 1) : walker(nullptr);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::walker BPlusTree<T, Compare, Lines>::pred(const T &x) {
+        if (!root) return walker(nullptr);
+        auto leaf = descend<true>(x);
+        auto i = rank<true>(leaf->keys, leaf->count, x);
+        if (i) return walker(leaf, i - 1);
+        return leaf->prev ? walker(leaf->prev, leaf->prev->count - 1) : walker(nullptr);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::walker BPlusTree<T, Compare, Lines>::succ(const T &x) {
+        if (!root) return walker(nullptr);
+        auto leaf = descend<false>(x);
+        auto i = rank<false>(leaf->keys, leaf->count, x);
+        if (i < leaf->count) return walker(leaf, i);
+        return walker(leaf->next);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    bool BPlusTree<T, Compare, Lines>::contains(const T &x) {
+        return find(x).valid();
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::iterator BPlusTree<T, Compare, Lines>::begin() {
+        return iterator(min(), this);
+    }
+
+    template<class T, class Compare, std::size_t Lines>
+    typename BPlusTree<T, Compare, Lines>::iterator BPlusTree<T, Compare, Lines>::end() {
+        return iterator(walker(nullptr), this);
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_B_PLUS_TREE_HPP
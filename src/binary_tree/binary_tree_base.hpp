@@ -9,6 +9,9 @@
 #include <compare.hpp>
 #include <utility>
 #include <stack>
+#include <thread>
+#include <type_traits>
+#include <vector>
 // min
 // max
 // merge
@@ -19,12 +22,10 @@ namespace data_structure {
     };
 
 
+    // not polymorphic: a tree only ever handles its own node type, so nodes carry no vtable pointer
     struct Node {
         Node *parent = nullptr, *children[2] = {nullptr, nullptr};
 
-        virtual ~Node() = default;
-
-
         inline void set_left(Node *n) noexcept;
 
         inline void set_right(Node *n) noexcept;
@@ -94,10 +95,10 @@ namespace data_structure {
         TreeNode *root = nullptr;
         Factory factory{};
 
-        virtual void clear();
+        void clear();
 
     public:
-        virtual ~BinTree() {
+        ~BinTree() {
             clear();
         }
     };
@@ -126,15 +127,18 @@ namespace data_structure {
 
     template<class T>
     struct BSTNode : public Node {
+        using plain_update = void (BSTNode::*)();
+
         T x;
 
         template<typename ...Args>
         explicit BSTNode(Args ...args) : x(std::forward<Args>(args)...) {}
 
-        virtual void update() {}
+        void update() {}
 
     };
 
+    // keeps the size of its subtree, which gives the trees rank, select and count_range
     template<class T>
     struct WeightedBSTNode : public Node {
         T x;
@@ -143,7 +147,7 @@ namespace data_structure {
         template<typename ...Args>
         explicit WeightedBSTNode(Args &&...args) : x(std::forward<Args>(args)...) {}
 
-        virtual void update() {
+        void update() {
             weight = 1 + (this->children[LEFT] ? static_cast<WeightedBSTNode *>(this->children[LEFT])->weight : 0) +
                      (this->children[RIGHT] ? static_cast<WeightedBSTNode *>(this->children[RIGHT])->weight : 0);
         }
@@ -151,26 +155,70 @@ namespace data_structure {
 
 
 
+    /*
+     * Keeps Monoid::combine of the elements of its subtree, in order, in summary. A Monoid provides value_type,
+     * identity(), lift(const T &) mapping an element to a value, and an associative combine(a, b); combine need not
+     * be commutative. Rotations and the bottom-up updates keep summary exact, which gives the trees fold(lo, hi).
+     */
+    template<class T, class Monoid>
+    struct AugmentedBSTNode : public Node {
+        using monoid = Monoid;
+
+        T x;
+        typename Monoid::value_type summary;
+
+        template<typename ...Args>
+        explicit AugmentedBSTNode(Args &&...args) : x(std::forward<Args>(args)...), summary(Monoid::lift(x)) {}
+
+        void update() {
+            summary = Monoid::lift(x);
+            if (this->children[LEFT])
+                summary = Monoid::combine(static_cast<AugmentedBSTNode *>(this->children[LEFT])->summary, summary);
+            if (this->children[RIGHT])
+                summary = Monoid::combine(summary, static_cast<AugmentedBSTNode *>(this->children[RIGHT])->summary);
+        }
+    };
+
+    // the trees skip the bottom-up updates of nodes that keep the empty update of BSTNode
+    template<class N, class = void>
+    struct is_augmented : std::true_type {};
+
+    template<class N>
+    struct is_augmented<N, std::void_t<typename N::plain_update>>
+            : std::bool_constant<!std::is_same_v<decltype(&N::update), typename N::plain_update>> {};
+
+    /*
+     * Nothing is virtual: a tree built on BSTree passes itself as Derived, and the base reaches the hooks a tree may
+     * redeclare (find_last) through self(), so every call is resolved at compile time and the search loops inline.
+     * Node::update is called on the tree's own node type, so augmented nodes need no virtual update either.
+     * As a consequence, a tree must be used through its own type, not through a reference to BSTree.
+     */
     template<class T, class Node = BSTNode<T>,
-            class Compare = utils::DefaultCompare<T>, class Factory = utils::TrivialFactory<Node>>
+            class Compare = utils::DefaultCompare<T>, class Factory = utils::TrivialFactory<Node>,
+            class Derived = void>
     class BSTree : public BinTree<Node, Factory> {
     protected:
+        using Self = std::conditional_t<std::is_void_v<Derived>, BSTree, Derived>;
+
         constexpr static Compare compare{};
         size_t n = 0;
+        bool counted = true; // false after a split, until size() counts the elements again
 
-        virtual Node *find_last(const T &x);
+        Self &self() noexcept { return static_cast<Self &>(*this); }
 
-        virtual bool adopt(Node *p, Node *u);
+        Node *find_last(const T &x);
 
-        virtual void splice(Node *u);
+        bool adopt(Node *p, Node *u);
 
-        virtual void erase(Node *u);
+        void splice(Node *u);
 
-        virtual void rotate(Node *u, Direction direction);
+        void erase(Node *u);
 
-        virtual bool insert(Node *u);
+        void rotate(Node *u, Direction direction);
 
-        virtual void bottom_up_update(Node *u);
+        bool insert(Node *u);
+
+        void bottom_up_update(Node *u);
 
         static Node *min_node(Node *u);
 
@@ -180,32 +228,118 @@ namespace data_structure {
 
         static Node *succ_node(Node *u);
 
+        static size_t weight(Node *u) { return u ? u->weight : 0; }
+
+        // number of elements less than x, or not greater than x without Strict
+        template<bool Strict>
+        size_t count_before(const T &x);
+
+        /*
+         * The join-based algorithms below take and return detached subtrees, whose roots have no parent, and reach the
+         * tree through self().join_node(l, m, r): it links the single node m between l and r, every element of l being
+         * less than m and every element of r greater, rebalances, and returns the root of the result.
+         */
+        struct Bulk {
+            std::vector<Node *> garbage; // subtrees to destroy once the threads are done
+            size_t common = 0;           // elements found in both trees
+        };
+
+        static void cut(Node *u, Node *&l, Node *&r);
+
+        // prepares a detached subtree to be the root of the tree, a hook for trees with rules about their root
+        static Node *as_root(Node *t) { return t; }
+
+        // elements less than x go to l and greater ones to r; returns the node holding x, detached, if any
+        Node *split_node(Node *t, const T &x, Node *&l, Node *&r);
+
+        // removes the maximum of t, returning it detached and the rest through rest
+        Node *split_last(Node *t, Node *&rest);
+
+        // joins l and r, every element of l being less than every one of r
+        Node *join2(Node *l, Node *r);
+
+        // moves the elements of the detached subtree t into nodes of the same shape built by to, destroying those of t
+        Node *transplant(Node *t, Factory &to);
+
+        // runs left and right, left on a new thread if more than one thread is allowed, each with half of them
+        template<class Left, class Right>
+        static void fork(size_t threads, Bulk &bulk, Left &&left, Right &&right);
+
+        Node *unite(Node *a, Node *b, Bulk &bulk, size_t threads);
+
+        Node *intersect(Node *a, Node *b, Bulk &bulk, size_t threads);
+
+        Node *subtract(Node *a, Node *b, Bulk &bulk, size_t threads);
+
+        void destroy(Bulk &bulk);
+
     public:
+        // whether the tree provides join_node, which split, join and the set operations need
+        constexpr static bool joinable = false;
+
         class walker;
 
         class iterator;
 
-        virtual bool insert(const T &x);
+        bool insert(const T &x);
+
+        bool erase(const T &x);
+
+        walker find(const T &x);
+
+        size_t size();
+
+        void clear();
+
+        walker min();
+
+        walker max();
+
+        walker top();
+
+        walker pred(const T &x);
+
+        walker succ(const T &x);
+
+        bool contains(const T &x);
 
-        virtual bool erase(const T &x);
+        // the order statistics below need a node keeping subtree weights, such as WeightedBSTNode
 
-        virtual walker find(const T &x);
+        // number of elements less than x
+        size_t rank(const T &x);
 
-        virtual size_t size();
+        // the element with k smaller ones, invalid if k >= size()
+        walker select(size_t k);
 
-        virtual void clear();
+        // number of elements in [lo, hi]
+        size_t count_range(const T &lo, const T &hi);
 
-        virtual walker min();
+        // Monoid::combine of the elements in [lo, hi], in order, or the identity if there is none; needs an AugmentedBSTNode
+        template<class N = Node>
+        typename N::monoid::value_type fold(const T &lo, const T &hi);
 
-        virtual walker max();
+        // the operations below need a joinable tree, such as Treap, AVLTree and RbTree
 
-        virtual walker top();
+        /*
+         * Moves the elements not less than x into right, whose elements are dropped. The nodes change hands in
+         * O(log n) when the factory lets any tree destroy them, as TrivialFactory does; with any other factory, such
+         * as the default PoolFactory, the k elements moved are rebuilt in the factory of right, in O(k + log n).
+         * The sizes are counted again when asked for.
+         */
+        void split(const T &x, Self &right);
 
-        virtual walker pred(const T &x);
+        // moves all elements of that, which must be greater than every element of this tree, to the end of this tree
+        void join(Self &that);
 
-        virtual walker succ(const T &x);
+        /*
+         * Set operations with the elements of that, leaving that empty. The trees are split around the root of one
+         * of them and both halves are processed recursively, the first one on a new thread while `threads` allows.
+         */
+        void unite(Self &that, size_t threads = std::thread::hardware_concurrency());
 
-        virtual bool contains(const T &x);
+        void intersect(Self &that, size_t threads = std::thread::hardware_concurrency());
+
+        void subtract(Self &that, size_t threads = std::thread::hardware_concurrency());
 
         iterator begin();
 
@@ -213,8 +347,8 @@ namespace data_structure {
 
     };
 
-    template<class T, class Node, class Compare, class Factory>
-    class BSTree<T, Node, Compare, Factory>::walker {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    class BSTree<T, Node, Compare, Factory, Derived>::walker {
         Node *node;
     public:
         explicit walker(Node *node) : node(node) {}
@@ -252,8 +386,8 @@ namespace data_structure {
 
     };
 
-    template<class T, class Node, class Compare, class Factory>
-    class BSTree<T, Node, Compare, Factory>::iterator {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    class BSTree<T, Node, Compare, Factory, Derived>::iterator {
         Node *node;
         BSTree *tree;
     public:
@@ -296,8 +430,8 @@ namespace data_structure {
         }
     };
 
-    template<class T, class Node, class Compare, class Factory>
-    Node *BSTree<T, Node, Compare, Factory>::find_last(const T &x) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::find_last(const T &x) {
         Node *w = this->root, *prev = nullptr;
         while (w != nullptr) {
             prev = w;
@@ -316,8 +450,8 @@ namespace data_structure {
         return prev;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    bool BSTree<T, Node, Compare, Factory>::adopt(Node *p, Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    bool BSTree<T, Node, Compare, Factory, Derived>::adopt(Node *p, Node *u) {
         if (p == nullptr) {
             this->root = u;
         } else {
@@ -339,8 +473,8 @@ namespace data_structure {
         return true;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    void BSTree<T, Node, Compare, Factory>::splice(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::splice(Node *u) {
         Node *s, *p;
         if (u->children[LEFT] != nullptr) {
             s = static_cast<Node *>(u->children[LEFT]);
@@ -365,8 +499,8 @@ namespace data_structure {
         n--;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    void BSTree<T, Node, Compare, Factory>::erase(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::erase(Node *u) {
         if (u->children[LEFT] == nullptr || u->children[RIGHT] == nullptr) {
             splice(u);
             this->factory.destroy(u);
@@ -380,8 +514,8 @@ namespace data_structure {
         }
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    void BSTree<T, Node, Compare, Factory>::rotate(Node *u, Direction direction) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::rotate(Node *u, Direction direction) {
         Node *w = static_cast<Node *>(u->children[!direction]);
         w->parent = u->parent;
         if (w->parent) {
@@ -402,22 +536,24 @@ namespace data_structure {
         w->update();
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    bool BSTree<T, Node, Compare, Factory>::insert(Node *u) {
-        return adopt(find_last(u->x), u);
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    bool BSTree<T, Node, Compare, Factory, Derived>::insert(Node *u) {
+        return adopt(self().find_last(u->x), u);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    void BSTree<T, Node, Compare, Factory>::bottom_up_update(Node *u) {
-        while (u) {
-            u->update();
-            u = static_cast<Node *>(u->parent);
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::bottom_up_update(Node *u) {
+        if constexpr (is_augmented<Node>::value) {
+            while (u) {
+                u->update();
+                u = static_cast<Node *>(u->parent);
+            }
         }
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    bool BSTree<T, Node, Compare, Factory>::insert(const T &x) {
-        auto p = find_last(x);
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    bool BSTree<T, Node, Compare, Factory, Derived>::insert(const T &x) {
+        auto p = self().find_last(x);
         if (!p || compare(x, p->x) != utils::Eq) {
             adopt(p, this->factory.construct(x));
             return true;
@@ -425,9 +561,9 @@ namespace data_structure {
         return false;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    bool BSTree<T, Node, Compare, Factory>::erase(const T &x) {
-        Node *u = find_last(x);
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    bool BSTree<T, Node, Compare, Factory, Derived>::erase(const T &x) {
+        Node *u = self().find_last(x);
         if (u && compare(x, u->x) == utils::Eq) {
             erase(u);
             return true;
@@ -435,24 +571,24 @@ namespace data_structure {
         return false;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    Node *BSTree<T, Node, Compare, Factory>::min_node(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::min_node(Node *u) {
         while (u && u->children[LEFT]) {
             u = static_cast<Node *>(u->children[LEFT]);
         }
         return u;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    Node *BSTree<T, Node, Compare, Factory>::max_node(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::max_node(Node *u) {
         while (u && u->children[RIGHT]) {
             u = static_cast<Node *>(u->children[RIGHT]);
         }
         return u;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    Node *BSTree<T, Node, Compare, Factory>::pred_node(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::pred_node(Node *u) {
         if (!u) return nullptr;
         if (u->children[LEFT]) return max_node(static_cast<Node *>(u->children[LEFT]));
         else {
@@ -463,8 +599,8 @@ namespace data_structure {
         }
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    Node *BSTree<T, Node, Compare, Factory>::succ_node(Node *u) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::succ_node(Node *u) {
         if (!u) return nullptr;
         if (u->children[RIGHT]) return min_node(static_cast<Node *>(u->children[RIGHT]));
         else {
@@ -475,13 +611,13 @@ namespace data_structure {
         }
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::top() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::top() {
         return BSTree::walker(this->root);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::find(const T &x) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::find(const T &x) {
         Node *w = static_cast<Node *>(this->root);
         while (w != nullptr) {
             auto comp = compare(x, w->x);
@@ -496,29 +632,35 @@ namespace data_structure {
         return walker(nullptr);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    size_t BSTree<T, Node, Compare, Factory>::size() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    size_t BSTree<T, Node, Compare, Factory, Derived>::size() {
+        if (!counted) {
+            n = 0;
+            for (auto u = min_node(this->root); u; u = succ_node(u)) n++;
+            counted = true;
+        }
         return n;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    void BSTree<T, Node, Compare, Factory>::clear() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::clear() {
         BinTree<Node, Factory>::clear();
         n = 0;
+        counted = true;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::min() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::min() {
         return BSTree::walker(min_node(this->root));
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::max() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::max() {
         return BSTree::walker(max_node(this->root));
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::succ(const T &x) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::succ(const T &x) {
         Node *u = static_cast<Node *>(this->root);
         while (u) {
             if (compare(u->x, x) != utils::Greater) u = static_cast<Node *>(u->children[RIGHT]);
@@ -531,8 +673,8 @@ namespace data_structure {
         return walker(u);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::walker BSTree<T, Node, Compare, Factory>::pred(const T &x) {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker BSTree<T, Node, Compare, Factory, Derived>::pred(const T &x) {
         Node *u = static_cast<Node *>(this->root);
         while (u) {
             if (compare(u->x, x) != utils::Less) u = static_cast<Node *>(u->children[LEFT]);
@@ -545,19 +687,322 @@ namespace data_structure {
         return walker(u);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    bool BSTree<T, Node, Compare, Factory>::contains(const T &x) {
-        auto t = find_last(x);
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    bool BSTree<T, Node, Compare, Factory, Derived>::contains(const T &x) {
+        auto t = self().find_last(x);
         return t && compare(t->x, x) == utils::Eq;
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::iterator BSTree<T, Node, Compare, Factory>::begin() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    template<bool Strict>
+    size_t BSTree<T, Node, Compare, Factory, Derived>::count_before(const T &x) {
+        size_t r = 0;
+        Node *u = this->root;
+        while (u) {
+            auto comp = compare(u->x, x);
+            if (comp == utils::Less || (!Strict && comp == utils::Eq)) {
+                r += weight(static_cast<Node *>(u->children[LEFT])) + 1;
+                u = static_cast<Node *>(u->children[RIGHT]);
+            } else {
+                u = static_cast<Node *>(u->children[LEFT]);
+            }
+        }
+        return r;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    size_t BSTree<T, Node, Compare, Factory, Derived>::rank(const T &x) {
+        return count_before<true>(x);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::walker
+    BSTree<T, Node, Compare, Factory, Derived>::select(size_t k) {
+        Node *u = this->root;
+        while (u) {
+            auto left = weight(static_cast<Node *>(u->children[LEFT]));
+            if (k < left) {
+                u = static_cast<Node *>(u->children[LEFT]);
+            } else if (k == left) {
+                break;
+            } else {
+                k -= left + 1;
+                u = static_cast<Node *>(u->children[RIGHT]);
+            }
+        }
+        return walker(u);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    size_t BSTree<T, Node, Compare, Factory, Derived>::count_range(const T &lo, const T &hi) {
+        if (compare(hi, lo) == utils::Less) return 0;
+        return count_before<false>(hi) - count_before<true>(lo);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    template<class N>
+    typename N::monoid::value_type BSTree<T, Node, Compare, Factory, Derived>::fold(const T &lo, const T &hi) {
+        using Monoid = typename N::monoid;
+        auto summary = [](Node *u) { return u ? u->summary : Monoid::identity(); };
+        // the highest node in [lo, hi] splits the range between its subtrees
+        Node *u = this->root;
+        while (u) {
+            if (compare(u->x, lo) == utils::Less) u = static_cast<Node *>(u->children[RIGHT]);
+            else if (compare(u->x, hi) == utils::Greater) u = static_cast<Node *>(u->children[LEFT]);
+            else break;
+        }
+        if (!u) return Monoid::identity();
+        // the left subtree contributes the elements not less than lo, found from the largest one downwards
+        auto left = Monoid::identity();
+        for (auto v = static_cast<Node *>(u->children[LEFT]); v;) {
+            if (compare(v->x, lo) != utils::Less) {
+                left = Monoid::combine(Monoid::combine(Monoid::lift(v->x),
+                                                       summary(static_cast<Node *>(v->children[RIGHT]))), left);
+                v = static_cast<Node *>(v->children[LEFT]);
+            } else {
+                v = static_cast<Node *>(v->children[RIGHT]);
+            }
+        }
+        // and the right subtree the elements not greater than hi, from the smallest one upwards
+        auto right = Monoid::identity();
+        for (auto v = static_cast<Node *>(u->children[RIGHT]); v;) {
+            if (compare(v->x, hi) != utils::Greater) {
+                right = Monoid::combine(right, Monoid::combine(summary(static_cast<Node *>(v->children[LEFT])),
+                                                               Monoid::lift(v->x)));
+                v = static_cast<Node *>(v->children[RIGHT]);
+            } else {
+                v = static_cast<Node *>(v->children[LEFT]);
+            }
+        }
+        return Monoid::combine(Monoid::combine(left, Monoid::lift(u->x)), right);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::cut(Node *u, Node *&l, Node *&r) {
+        l = static_cast<Node *>(u->children[LEFT]);
+        r = static_cast<Node *>(u->children[RIGHT]);
+        if (l) l->parent = nullptr;
+        if (r) r->parent = nullptr;
+        u->parent = u->children[LEFT] = u->children[RIGHT] = nullptr;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::split_node(Node *t, const T &x, Node *&l, Node *&r) {
+        if (!t) {
+            l = r = nullptr;
+            return nullptr;
+        }
+        Node *a, *b, *found = nullptr;
+        cut(t, a, b);
+        auto comp = compare(x, t->x);
+        if (comp == utils::Less) {
+            found = split_node(a, x, l, a);
+            r = self().join_node(a, t, b);
+        } else if (comp == utils::Greater) {
+            found = split_node(b, x, b, r);
+            l = self().join_node(a, t, b);
+        } else {
+            l = a;
+            r = b;
+            found = t;
+        }
+        return found;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::split_last(Node *t, Node *&rest) {
+        Node *a, *b;
+        cut(t, a, b);
+        if (!b) {
+            rest = a;
+            return t;
+        }
+        auto last = split_last(b, b);
+        rest = self().join_node(a, t, b);
+        return last;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::join2(Node *l, Node *r) {
+        if (!l) return r;
+        auto last = split_last(l, l);
+        return self().join_node(l, last, r);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    template<class Left, class Right>
+    void BSTree<T, Node, Compare, Factory, Derived>::fork(size_t threads, Bulk &bulk, Left &&left, Right &&right) {
+        if (threads < 2) {
+            left(bulk, 1);
+            right(bulk, 1);
+            return;
+        }
+        Bulk other;
+        std::thread thread([&] { left(other, threads / 2); });
+        right(bulk, threads - threads / 2);
+        thread.join();
+        bulk.garbage.insert(bulk.garbage.end(), other.garbage.begin(), other.garbage.end());
+        bulk.common += other.common;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::unite(Node *a, Node *b, Bulk &bulk, size_t threads) {
+        if (!a) return b;
+        if (!b) return a;
+        Node *al, *ar, *bl, *br;
+        cut(a, al, ar);
+        if (auto found = split_node(b, a->x, bl, br)) {
+            bulk.garbage.push_back(found);
+            bulk.common++;
+        }
+        fork(threads, bulk, [&](Bulk &part, size_t share) { al = unite(al, bl, part, share); },
+             [&](Bulk &part, size_t share) { ar = unite(ar, br, part, share); });
+        return self().join_node(al, a, ar);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::intersect(Node *a, Node *b, Bulk &bulk, size_t threads) {
+        if (!a || !b) {
+            if (a) bulk.garbage.push_back(a);
+            if (b) bulk.garbage.push_back(b);
+            return nullptr;
+        }
+        Node *al, *ar, *bl, *br;
+        cut(a, al, ar);
+        auto found = split_node(b, a->x, bl, br);
+        fork(threads, bulk, [&](Bulk &part, size_t share) { al = intersect(al, bl, part, share); },
+             [&](Bulk &part, size_t share) { ar = intersect(ar, br, part, share); });
+        if (found) {
+            bulk.garbage.push_back(found);
+            bulk.common++;
+            return self().join_node(al, a, ar);
+        }
+        bulk.garbage.push_back(a);
+        return join2(al, ar);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::subtract(Node *a, Node *b, Bulk &bulk, size_t threads) {
+        if (!a || !b) {
+            if (b) bulk.garbage.push_back(b);
+            return a;
+        }
+        Node *al, *ar, *bl, *br;
+        cut(b, bl, br);
+        if (auto found = split_node(a, b->x, al, ar)) {
+            bulk.garbage.push_back(found);
+            bulk.common++;
+        }
+        bulk.garbage.push_back(b);
+        fork(threads, bulk, [&](Bulk &part, size_t share) { al = subtract(al, bl, part, share); },
+             [&](Bulk &part, size_t share) { ar = subtract(ar, br, part, share); });
+        return join2(al, ar);
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::destroy(Bulk &bulk) {
+        auto &stack = bulk.garbage;
+        while (!stack.empty()) {
+            auto u = stack.back();
+            stack.pop_back();
+            if (u->children[LEFT]) stack.push_back(static_cast<Node *>(u->children[LEFT]));
+            if (u->children[RIGHT]) stack.push_back(static_cast<Node *>(u->children[RIGHT]));
+            this->factory.destroy(u);
+        }
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    Node *BSTree<T, Node, Compare, Factory, Derived>::transplant(Node *t, Factory &to) {
+        if (!t) return nullptr;
+        auto l = transplant(static_cast<Node *>(t->children[LEFT]), to);
+        auto r = transplant(static_cast<Node *>(t->children[RIGHT]), to);
+        // an rvalue picks the implicit move constructor over the forwarding ones of the nodes
+        auto u = to.construct(std::move(*t));
+        this->factory.destroy(t);
+        u->parent = nullptr;
+        u->set_children(l, r);
+        return u;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::split(const T &x, Self &right) {
+        static_assert(Self::joinable, "split needs a tree providing join_node");
+        right.clear();
+        Node *l, *r;
+        if (auto found = split_node(this->root, x, l, r)) {
+            r = self().join_node(nullptr, found, r);
+        }
+        if constexpr (!Factory::detachable) r = transplant(r, right.factory);
+        this->root = self().as_root(l);
+        right.root = self().as_root(r);
+        counted = right.counted = false;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::join(Self &that) {
+        static_assert(Self::joinable, "join needs a tree providing join_node");
+        static_assert(Factory::meldable, "joining trees moves the nodes of one factory into the other");
+        if (!that.root) return;
+        this->factory.absorb(that.factory);
+        this->root = self().as_root(join2(this->root, that.root));
+        n += that.n;
+        counted = counted && that.counted;
+        that.root = nullptr;
+        that.n = 0;
+        that.counted = true;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::unite(Self &that, size_t threads) {
+        static_assert(Self::joinable, "set operations need a tree providing join_node");
+        static_assert(Factory::meldable, "set operations move the nodes of one factory into the other");
+        this->factory.absorb(that.factory);
+        Bulk bulk;
+        this->root = self().as_root(unite(this->root, that.root, bulk, threads));
+        destroy(bulk);
+        n += that.n - bulk.common;
+        counted = counted && that.counted;
+        that.root = nullptr;
+        that.n = 0;
+        that.counted = true;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::intersect(Self &that, size_t threads) {
+        static_assert(Self::joinable, "set operations need a tree providing join_node");
+        static_assert(Factory::meldable, "set operations move the nodes of one factory into the other");
+        this->factory.absorb(that.factory);
+        Bulk bulk;
+        this->root = self().as_root(intersect(this->root, that.root, bulk, threads));
+        destroy(bulk);
+        n = bulk.common;
+        counted = true;
+        that.root = nullptr;
+        that.n = 0;
+        that.counted = true;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    void BSTree<T, Node, Compare, Factory, Derived>::subtract(Self &that, size_t threads) {
+        static_assert(Self::joinable, "set operations need a tree providing join_node");
+        static_assert(Factory::meldable, "set operations move the nodes of one factory into the other");
+        this->factory.absorb(that.factory);
+        Bulk bulk;
+        this->root = self().as_root(subtract(this->root, that.root, bulk, threads));
+        destroy(bulk);
+        n -= bulk.common;
+        that.root = nullptr;
+        that.n = 0;
+        that.counted = true;
+    }
+
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::iterator BSTree<T, Node, Compare, Factory, Derived>::begin() {
         return BSTree::iterator(min_node(this->root), this);
     }
 
-    template<class T, class Node, class Compare, class Factory>
-    typename BSTree<T, Node, Compare, Factory>::iterator BSTree<T, Node, Compare, Factory>::end() {
+    template<class T, class Node, class Compare, class Factory, class Derived>
+    typename BSTree<T, Node, Compare, Factory, Derived>::iterator BSTree<T, Node, Compare, Factory, Derived>::end() {
         return BSTree::iterator(nullptr, this);
     }
 
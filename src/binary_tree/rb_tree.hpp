@@ -6,31 +6,35 @@
 #define DATA_STRUCTURE_FOR_LOVE_RE_TREE_HPP
 
 #include <binary_tree_base.hpp>
+#include <algorithm>
 
 namespace data_structure {
     enum class Color {
         RED, BLACK, DOUBLY_BLACK
     };
 
-    template<class T>
-    struct RBTNode : public BSTNode<T> {
+    // Base is BSTNode, or an augmented node such as WeightedBSTNode
+    template<class T, class Base = BSTNode<T>>
+    struct RBTNode : public Base {
         Color color;
 
-        explicit RBTNode(const T &x) : BSTNode<T>(x), color(Color::RED) {}
+        explicit RBTNode(const T &x) : Base(x), color(Color::RED) {}
 
         template<typename ...Args>
-        explicit RBTNode(Color col, Args &&...args) : color(col), BSTNode<T>(std::forward<Args>(args)...) {}
+        explicit RBTNode(Color col, Args &&...args) : Base(std::forward<Args>(args)...), color(col) {}
 
     };
 
 
     template<class T, class Node = RBTNode<T>,
             class Compare = utils::DefaultCompare<T>, class Factory = utils::PoolFactory<Node>>
-    class RbTree : public BSTree<T, Node, Compare, Factory> {
+    class RbTree : public BSTree<T, Node, Compare, Factory, RbTree<T, Node, Compare, Factory>> {
     protected:
+        using Base = BSTree<T, Node, Compare, Factory, RbTree>;
+        friend Base; // split and the set operations of the base join through join_node
         using BinTree<Node, Factory>::factory;
-        using BSTree<T, Node, Compare, Factory>::compare;
-        using BSTree<T, Node, Compare, Factory>::n;
+        using Base::compare;
+        using Base::n;
 
         template<typename _Node, typename _Color, typename ...More>
         void set_colors(_Node *a, _Color b, More ...more) {
@@ -63,11 +67,25 @@ namespace data_structure {
 
         Node *del(Node *t, Node *x);
 
+        // black nodes on the leftmost path of t, which has a black root
+        static int black_height(Node *t);
+
+        // links m between l and r: with roots made black, m goes red in place of the first black node on the facing
+        // spine of the tree with more black levels that has as many as the other tree, and is fixed like an insertion
+        Node *join_node(Node *l, Node *m, Node *r);
+
+        static Node *as_root(Node *t) {
+            if (t) t->color = Color::BLACK;
+            return t;
+        }
+
     public:
+        constexpr static bool joinable = true;
 
-        bool insert(const T &x) override;
 
-        bool erase(const T &x) override;
+        bool insert(const T &x);
+
+        bool erase(const T &x);
 
     };
 
@@ -254,7 +272,10 @@ namespace data_structure {
         }
         t->color = Color::BLACK;
         if (deb) {
+            // the placeholder may have been counted by the rotations
+            auto parent = static_cast<Node *>(deb->parent);
             deb->replace_with(nullptr);
+            this->bottom_up_update(parent);
             factory.destroy(deb);
         }
         return t;
@@ -270,9 +291,11 @@ namespace data_structure {
         if (static_cast<Node *>(x->children[LEFT]) == nullptr) {
             db = static_cast<Node *>(x->children[RIGHT]);
             x->replace_with(db);
+            if (!parent) t = db;
         } else if (static_cast<Node *>(x->children[RIGHT]) == nullptr) {
             db = static_cast<Node *>(x->children[LEFT]);
             x->replace_with(db);
+            if (!parent) t = db;
         } else {
             y = this->min_node(static_cast<Node *>(x->children[RIGHT]));
             parent = static_cast<Node *>(y->parent);
@@ -281,12 +304,50 @@ namespace data_structure {
             y->replace_with(db);
             x = y;
         }
+        this->bottom_up_update(parent);
         if (x->color == Color::BLACK)
             t = delete_fix(t, make_black(parent, db), db == nullptr);
         remove(x);
         return t;
     }
 
+    template<class T, class Node, class Compare, class Factory>
+    int RbTree<T, Node, Compare, Factory>::black_height(Node *t) {
+        int h = 0;
+        for (; t; t = static_cast<Node *>(t->children[LEFT])) h += t->color == Color::BLACK;
+        return h;
+    }
+
+    template<class T, class Node, class Compare, class Factory>
+    Node *RbTree<T, Node, Compare, Factory>::join_node(Node *l, Node *m, Node *r) {
+        // a red root may turn black without breaking anything
+        if (l) l->color = Color::BLACK;
+        if (r) r->color = Color::BLACK;
+        auto hl = black_height(l), hr = black_height(r);
+        if (hl == hr) {
+            m->set_children(l, r);
+            m->color = Color::BLACK;
+            m->update();
+            return m;
+        }
+        auto d = hl > hr ? RIGHT : LEFT;
+        Node *t = d == RIGHT ? l : r, *s = d == RIGHT ? r : l, *c = t, *p = nullptr;
+        auto hs = std::min(hl, hr), hc = std::max(hl, hr);
+        while (!is_black(c) || hc != hs) {
+            hc -= c->color == Color::BLACK;
+            p = c;
+            c = static_cast<Node *>(c->children[d]);
+        }
+        if (d == RIGHT) m->set_children(c, s);
+        else m->set_children(s, c);
+        m->color = Color::RED;
+        p->children[d] = m;
+        m->parent = p;
+        m->update();
+        this->bottom_up_update(p);
+        return insert_fix(t, m);
+    }
+
     template<class T, class Node, class Compare, class Factory>
     bool RbTree<T, Node, Compare, Factory>::insert(const T &x) {
         auto new_root = insert(this->root, x);
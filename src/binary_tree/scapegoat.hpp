@@ -7,16 +7,18 @@
 
 #include <binary_tree_base.hpp>
 #include <cmath>
+#include <tuple>
 
 namespace data_structure {
     template<class T, class Node = WeightedBSTNode<T>,
             class Compare = utils::DefaultCompare<T>, class Factory = utils::PoolFactory<Node>>
-    class ScapeGoat : public BSTree<T, Node, Compare, Factory> {
+    class ScapeGoat : public BSTree<T, Node, Compare, Factory, ScapeGoat<T, Node, Compare, Factory>> {
     protected:
+        using Base = BSTree<T, Node, Compare, Factory, ScapeGoat>;
         using BinTree<Node, Factory>::root;
         using BinTree<Node, Factory>::factory;
-        using BSTree<T, Node, Compare, Factory>::compare;
-        using BSTree<T, Node, Compare, Factory>::n;
+        using Base::compare;
+        using Base::n;
         size_t q = 0;
 
         size_t pack(Node *u, Node **array, size_t i);
@@ -29,12 +31,13 @@ namespace data_structure {
 
         constexpr static double __factor = 2.4663034623764317;
 
-        std::tuple<size_t, Node **, Node *> find_position(const T &x);
+        // the depth of the new leaf, whether x is new, its parent and the side of the parent it goes to
+        std::tuple<size_t, bool, Node *, Direction> find_position(const T &x);
 
     public:
-        virtual bool insert(const T &x);
+        bool insert(const T &x);
 
-        virtual bool erase(const T &x);
+        bool erase(const T &x);
     };
 
     template<class T, class Node, class Compare, class Factory>
@@ -91,7 +94,8 @@ namespace data_structure {
         if (!std::get<1>(pos)) return false;
         else {
             Node *u = factory.construct(x);
-            *std::get<1>(pos) = u;
+            if (auto p = std::get<2>(pos)) p->children[std::get<3>(pos)] = u;
+            else root = u;
             u->parent = std::get<2>(pos);
             this->bottom_up_update(u);
             if (std::get<0>(pos) > factor(q)) {
@@ -106,46 +110,45 @@ namespace data_structure {
     }
 
     template<class T, class Node, class Compare, class Factory>
-    std::tuple<size_t, Node **, Node *> ScapeGoat<T, Node, Compare, Factory>::find_position(const T &x) {
+    std::tuple<size_t, bool, Node *, Direction> ScapeGoat<T, Node, Compare, Factory>::find_position(const T &x) {
         Node *w = root;
         if (w == nullptr) {
             n++;
             q++;
-            return {0, &root, nullptr};
+            return {0, true, nullptr, LEFT};
         }
         bool done = false;
         size_t d = 0;
-        Node **result = nullptr, *father = nullptr;
+        Direction side = LEFT;
         do {
             auto res = compare(x, w->x);
             if (res == utils::Less) {
                 if (w->children[LEFT] == nullptr) {
-                    father = w;
-                    result = reinterpret_cast<Node **>(&w->children[LEFT]);
+                    side = LEFT;
                     done = true;
                 } else {
                     w = static_cast<Node *>(w->children[LEFT]);
                 }
             } else if (res == utils::Greater) {
                 if (w->children[RIGHT] == nullptr) {
-                    father = w;
-                    result = reinterpret_cast<Node **>(&w->children[RIGHT]);
+                    side = RIGHT;
                     done = true;
+                } else {
+                    w = static_cast<Node *>(w->children[RIGHT]);
                 }
-                w = static_cast<Node *>(w->children[RIGHT]);
             } else {
-                return {d, nullptr, nullptr};
+                return {d, false, nullptr, LEFT};
             }
             d++;
         } while (!done);
         n++;
         q++;
-        return {d, result, father};
+        return {d, true, w, side};
     }
 
     template<class T, class Node, class Compare, class Factory>
     bool ScapeGoat<T, Node, Compare, Factory>::erase(const T &x) {
-        if (BSTree<T, Node, Compare, Factory>::erase(x)) {
+        if (Base::erase(x)) {
             if (!root) {
                 q = 0;
             } else if ((n << 1) < q) {
@@ -10,31 +10,36 @@
 namespace data_structure {
     template<class T, class Node = BSTNode<T>,
             class Compare = utils::DefaultCompare<T>, class Factory = utils::PoolFactory<Node>>
-    class Splay : public BSTree<T, Node, Compare, Factory> {
+    class Splay : public BSTree<T, Node, Compare, Factory, Splay<T, Node, Compare, Factory>> {
     protected:
+        using Base = BSTree<T, Node, Compare, Factory, Splay>;
+        friend Base; // contains of the base splays through find_last
         using BinTree<Node, Factory>::root;
         using BinTree<Node, Factory>::factory;
-        using BSTree<T, Node, Compare, Factory>::compare;
-        using BSTree<T, Node, Compare, Factory>::n;
+        using Base::compare;
+        using Base::n;
 
-        void splay(Node *u, Node **target);
+        // rotates u up until its parent is top; a null top splays u to the root
+        void splay(Node *u, Node *top);
 
-        virtual Node *find_last(const T &x);
+        Node *find_last(const T &x);
 
 
     public:
-        virtual bool insert(const T &x);
+        bool insert(const T &x);
 
-        virtual bool erase(const T &x);
+        bool erase(const T &x);
 
 
     };
 
     template<class T, class Node, class Compare, class Factory>
-    void Splay<T, Node, Compare, Factory>::splay(Node *u, Node **target) {
-        while ((*target) != u) {
-            if (u->parent == (*target)) {
-                this->rotate((*target), (*target)->children[LEFT] == u ? RIGHT : LEFT);
+    void Splay<T, Node, Compare, Factory>::splay(Node *u, Node *top) {
+        if (!u) return;
+        while (u->parent != top) {
+            auto p = static_cast<Node *>(u->parent);
+            if (p->parent == top) {
+                this->rotate(p, p->children[LEFT] == u ? RIGHT : LEFT);
             } else if (u == u->parent->children[LEFT] && u->parent == u->parent->parent->children[LEFT]) {
                 this->rotate(static_cast<Node *>(u->parent->parent), RIGHT);
                 this->rotate(static_cast<Node *>(u->parent), RIGHT);
@@ -53,18 +58,18 @@ namespace data_structure {
 
     template<class T, class Node, class Compare, class Factory>
     Node *Splay<T, Node, Compare, Factory>::find_last(const T &x) {
-        auto m = BSTree<T, Node, Compare, Factory>::find_last(x);
-        splay(m, &root);
+        auto m = Base::find_last(x);
+        splay(m, nullptr);
         return root;
     }
 
     template<class T, class Node, class Compare, class Factory>
     bool Splay<T, Node, Compare, Factory>::insert(const T &x) {
-        auto p = BSTree<T, Node, Compare, Factory>::find_last(x);
+        auto p = Base::find_last(x);
         if (!p || compare(x, p->x) != utils::Eq) {
             auto node = this->factory.construct(x);
             this->adopt(p, node);
-            splay(node, &root);
+            splay(node, nullptr);
             return true;
         }
         return false;
@@ -78,8 +83,7 @@ namespace data_structure {
             this->splice(p);
             factory.destroy(p);
         } else {
-            splay(this->max_node(static_cast<Node *>(p->children[LEFT])),
-                  reinterpret_cast<Node **>(&p->children[LEFT]));
+            splay(this->max_node(static_cast<Node *>(p->children[LEFT])), p);
             p->children[RIGHT]->parent = p->children[LEFT];
             p->children[LEFT]->children[RIGHT] = p->children[RIGHT];
             root = static_cast<Node *>(p->children[LEFT]);
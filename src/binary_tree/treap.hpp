@@ -8,32 +8,40 @@
 #include <binary_tree_base.hpp>
 #include <static_random_helper.hpp>
 namespace data_structure {
-    template<class T>
-    struct TreapNode : public BSTNode<T> {
+    // Base is BSTNode, or an augmented node such as WeightedBSTNode
+    template<class T, class Base = BSTNode<T>>
+    struct TreapNode : public Base {
         std::size_t p;
 
         template<typename ...Args>
-        explicit TreapNode(std::size_t p, Args &&...args) : p(p), BSTNode<T>(std::forward<Args>(args)...) {}
+        explicit TreapNode(std::size_t p, Args &&...args) : Base(std::forward<Args>(args)...), p(p) {}
     };
 
     template<class T, class Node = TreapNode<T>,
             class Compare = utils::DefaultCompare<T>, class Factory = utils::PoolFactory<Node>>
-    class Treap : public BSTree<T, Node, Compare, Factory> {
+    class Treap : public BSTree<T, Node, Compare, Factory, Treap<T, Node, Compare, Factory>> {
     protected:
+        using Base = BSTree<T, Node, Compare, Factory, Treap>;
+        friend Base; // split and the set operations of the base join through join_node
         using BinTree<Node, Factory>::root;
         using BinTree<Node, Factory>::factory;
-        using BSTree<T, Node, Compare, Factory>::compare;
-        using BSTree<T, Node, Compare, Factory>::n;
+        using Base::compare;
+        using Base::n;
         static utils::RandomIntGen<std::size_t> rand;
 
         void bubble_up(Node *u);
 
         void trickle_down(Node *u);
 
+        // the root with the smallest priority stays on top, so a join descends O(log n) levels in expectation
+        Node *join_node(Node *l, Node *m, Node *r);
+
     public:
-        virtual bool insert(const T &x);
+        constexpr static bool joinable = true;
+
+        bool insert(const T &x);
 
-        virtual bool erase(const T &x);
+        bool erase(const T &x);
     };
 
     template<class T, class Node, class Compare, class Factory>
@@ -70,6 +78,27 @@ namespace data_structure {
 
     }
 
+    template<class T, class Node, class Compare, class Factory>
+    Node *Treap<T, Node, Compare, Factory>::join_node(Node *l, Node *m, Node *r) {
+        if (l && l->p < m->p && (!r || l->p <= r->p)) {
+            Node *a, *b;
+            Base::cut(l, a, b);
+            l->set_children(a, join_node(b, m, r));
+            l->update();
+            return l;
+        }
+        if (r && r->p < m->p) {
+            Node *a, *b;
+            Base::cut(r, a, b);
+            r->set_children(join_node(l, m, a), b);
+            r->update();
+            return r;
+        }
+        m->set_children(l, r);
+        m->update();
+        return m;
+    }
+
     template<class T, class Node, class Compare, class Factory>
     bool Treap<T, Node, Compare, Factory>::insert(const T &x) {
         auto p = this->find_last(x);
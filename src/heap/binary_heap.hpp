@@ -5,61 +5,54 @@
 #ifndef DATA_STRUCTURE_FOR_LOVE_BINARY_HEAP_HPP
 #define DATA_STRUCTURE_FOR_LOVE_BINARY_HEAP_HPP
 
-#include <random>
 #include <heap_base.hpp>
-#include <chrono>
-#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 namespace data_structure {
-    template<typename T>
-    struct BinaryHeapNode {
-        BinaryHeapNode *father = nullptr, *left = nullptr, *right = nullptr;
-        size_t size = 0;
-        T value;
-
-        explicit BinaryHeapNode(const T &t) : value(t) {};
-
-        template<typename ...Args>
-        explicit BinaryHeapNode(Args &&...args): value(std::forward<Args>(args)...) {};
-    };
-
+    /*
+     * Implicit binary heap: the tree is laid out level by level in one contiguous array, the children of the
+     * element at index i live at 2i + 1 and 2i + 2. Sifting moves the displaced element into a hole instead of
+     * swapping, so every level costs one move and at most one cache miss.
+     */
     template<typename T,
             typename Compare = std::less<T>,
-            typename Alloc = std::allocator<BinaryHeapNode<T>>>
+            typename Alloc = std::allocator<T>>
     class BinaryHeap : public Heap<T, Compare> {
         constexpr static Compare compare{};
 
-        Alloc alloc{};
-        BinaryHeapNode<T> *root = nullptr;
+        std::vector<T, Alloc> data;
+
+        void sift_up(size_t i);
 
-        void destroy(BinaryHeapNode<T> *node);
+        void sift_down(size_t i);
+
+        void heapify();
 
     public:
-        ~BinaryHeap();
+        BinaryHeap() = default;
 
-        void push(const T &t) override;
+        BinaryHeap(const std::initializer_list<T> &list);
 
-#ifdef DEBUG
-        void debug(BinaryHeapNode<T>* m, const std::string& t = "    ") {
-            if (m) {
-                std::cout << t  << "value: " << m->value <<", size: " << m->size ;
+        // O(n) bulk construction
+        template<typename InputIt>
+        BinaryHeap(InputIt first, InputIt last);
 
-                if(m->father) std::cout << ", father: "<< m->father->value << std::endl;
-                else std::cout << std::endl;
-                debug(m->left, "    " + t);
-                debug(m->right, "    " + t);
-            }
-        }
+        explicit BinaryHeap(std::vector<T, Alloc> values);
 
+        void push(const T &t) override;
 
-        void debug() {
-            debug(root);
-        }
-#endif //DEBUG
+        void push(T &&t);
 
         template<typename ...Args>
         void emplace(Args &&...args);
 
+        // inserts all elements of the range, with one bottom-up heapify when they outnumber the present ones
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
         size_t size() const override;
 
         const T &top() override;
@@ -67,181 +60,107 @@ namespace data_structure {
         void pop() override;
 
         bool empty() override;
+
+        void reserve(size_t n);
     };
 
     template<typename T, typename Compare, typename Alloc>
-    void BinaryHeap<T, Compare, Alloc>::destroy(BinaryHeapNode<T> *node) {
-        if (!node) return;
-        destroy(node->left);
-        destroy(node->right);
-        alloc.destroy(node);
-        alloc.deallocate(node, 1);
+    void BinaryHeap<T, Compare, Alloc>::sift_up(size_t i) {
+        T value = std::move(data[i]);
+        while (i) {
+            auto father = (i - 1) >> 1u;
+            if (!compare(value, data[father])) break;
+            data[i] = std::move(data[father]);
+            i = father;
+        }
+        data[i] = std::move(value);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void BinaryHeap<T, Compare, Alloc>::sift_down(size_t i) {
+        auto n = data.size();
+        T value = std::move(data[i]);
+        for (auto child = 2 * i + 1; child < n; child = 2 * i + 1) {
+            if (child + 1 < n && compare(data[child + 1], data[child])) ++child;
+            if (!compare(data[child], value)) break;
+            data[i] = std::move(data[child]);
+            i = child;
+        }
+        data[i] = std::move(value);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void BinaryHeap<T, Compare, Alloc>::heapify() {
+        for (auto i = data.size() / 2; i-- > 0;) sift_down(i);
     }
 
     template<typename T, typename Compare, typename Alloc>
-    BinaryHeap<T, Compare, Alloc>::~BinaryHeap() {
-        destroy(root);
+    BinaryHeap<T, Compare, Alloc>::BinaryHeap(const std::initializer_list<T> &list) : data(list) {
+        heapify();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<typename InputIt>
+    BinaryHeap<T, Compare, Alloc>::BinaryHeap(InputIt first, InputIt last) : data(first, last) {
+        heapify();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    BinaryHeap<T, Compare, Alloc>::BinaryHeap(std::vector<T, Alloc> values) : data(std::move(values)) {
+        heapify();
     }
 
     template<typename T, typename Compare, typename Alloc>
     void BinaryHeap<T, Compare, Alloc>::push(const T &t) {
-        BinaryHeapNode<T> **ptr = &root, *old = nullptr;
-        while (*ptr) {
-            old = *ptr;
-            if ((old->size - (old->left ? old->left->size : 0)) >= (old->left ? old->left->size : 0)) {
-                ptr = &old->left;
-            } else {
-                ptr = &old->right;
-            }
-            ++old->size;
-        }
-        *ptr = alloc.allocate(1);
-        alloc.construct(*ptr, t);
-        (*ptr)->father = old;
-        old = *ptr;
-        old->size = 1;
-        while (old->father && compare(old->value, old->father->value)) {
-            std::swap(old->father->size, old->size);
-            if (old->father->father) {
-                if (old->father->father->left == old->father) {
-                    old->father->father->left = old;
-                } else {
-                    old->father->father->right = old;
-                }
-            }
-            if (old == old->father->left) {
-                if (old->father->right) {
-                    old->father->right->father = old;
-                }
-                if (old->left) {
-                    old->left->father = old->father;
-                }
-                if (old->right) {
-                    old->right->father = old->father;
-                }
-                std::swap(old->right, old->father->right);
-                old->father->left = old->left;
-                old->left = old->father;
-                old->father = old->left->father;
-                old->left->father = old;
-            } else {
-                if (old->father->left) {
-                    old->father->left->father = old;
-                }
-                if (old->left) {
-                    old->left->father = old->father;
-                }
-                if (old->right) {
-                    old->right->father = old->father;
-                }
-                std::swap(old->left, old->father->left);
-                old->father->right = old->right;
-                old->right = old->father;
-                old->father = old->right->father;
-                old->right->father = old;
-            }
-            if (!old->father) root = old;
-        }
+        data.push_back(t);
+        sift_up(data.size() - 1);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void BinaryHeap<T, Compare, Alloc>::push(T &&t) {
+        data.push_back(std::move(t));
+        sift_up(data.size() - 1);
     }
 
     template<typename T, typename Compare, typename Alloc>
     template<typename... Args>
     void BinaryHeap<T, Compare, Alloc>::emplace(Args &&... args) {
-        BinaryHeapNode<T> **ptr = &root, *old = nullptr;
-        while (*ptr) {
-            old = *ptr;
-            if ((old->size - (old->left ? old->left->size : 0)) >= (old->left ? old->left->size : 0)) {
-                ptr = &old->left;
-            } else {
-                ptr = &old->right;
-            }
-            ++old->size;
-        }
-        *ptr = alloc.allocate(1);
-        alloc.construct(*ptr, std::forward<Args>(args)...);
-        (*ptr)->father = old;
-        old = *ptr;
-        old->size = 1;
-        while (old->father && compare(old->value, old->father->value)) {
-            std::swap(old->father->size, old->size);
-            if (old->father->father) {
-                if (old->father->father->left == old->father) {
-                    old->father->father->left = old;
-                } else {
-                    old->father->father->right = old;
-                }
-            }
-            if (old == old->father->left) {
-                if (old->father->right) {
-                    old->father->right->father = old;
-                }
-                if (old->left) {
-                    old->left->father = old->father;
-                }
-                if (old->right) {
-                    old->right->father = old->father;
-                }
-                std::swap(old->right, old->father->right);
-                old->father->left = old->left;
-                old->left = old->father;
-                old->father = old->left->father;
-                old->left->father = old;
-            } else {
-                if (old->father->left) {
-                    old->father->left->father = old;
-                }
-                if (old->left) {
-                    old->left->father = old->father;
-                }
-                if (old->right) {
-                    old->right->father = old->father;
-                }
-                std::swap(old->left, old->father->left);
-                old->father->right = old->right;
-                old->right = old->father;
-                old->father = old->right->father;
-                old->right->father = old;
-            }
-            if (!old->father) root = old;
-        }
+        data.emplace_back(std::forward<Args>(args)...);
+        sift_up(data.size() - 1);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<typename InputIt>
+    void BinaryHeap<T, Compare, Alloc>::push_range(InputIt first, InputIt last) {
+        auto old = data.size();
+        data.insert(data.end(), first, last);
+        if (data.size() - old > old) heapify();
+        else for (auto i = old; i < data.size(); ++i) sift_up(i);
     }
 
     template<typename T, typename Compare, typename Alloc>
-    size_t BinaryHeap<T, Compare, Alloc>::size() const { return root ? root->size : 0; }
+    size_t BinaryHeap<T, Compare, Alloc>::size() const { return data.size(); }
 
     template<typename T, typename Compare, typename Alloc>
-    const T &BinaryHeap<T, Compare, Alloc>::top() { return root->value; }
+    const T &BinaryHeap<T, Compare, Alloc>::top() { return data.front(); }
 
     template<typename T, typename Compare, typename Alloc>
     void BinaryHeap<T, Compare, Alloc>::pop() {
-        if (!root) return;
-        auto p = root;
-        while (p->left || p->right) {
-            p->size--;
-            if (!p->left || (p->right && !compare(p->left->value, p->right->value))) {
-                std::swap(p->value, p->right->value);
-                p = p->right;
-            } else {
-                std::swap(p->value, p->left->value);
-                p = p->left;
-            }
-        }
-        if (p->father) {
-            if (p == p->father->left) p->father->left = nullptr;
-            else p->father->right = nullptr;
-        } else {
-            root = nullptr;
-        }
-        this->alloc.destroy(p);
-        this->alloc.deallocate(p, 1);
+        if (data.empty()) return;
+        if (data.size() > 1) data.front() = std::move(data.back());
+        data.pop_back();
+        if (data.size() > 1) sift_down(0);
     }
 
     template<typename T, typename Compare, typename Alloc>
     bool BinaryHeap<T, Compare, Alloc>::empty() {
-        return !root;
+        return data.empty();
     }
 
-
+    template<typename T, typename Compare, typename Alloc>
+    void BinaryHeap<T, Compare, Alloc>::reserve(size_t n) {
+        data.reserve(n);
+    }
 }
 
 #endif //DATA_STRUCTURE_FOR_LOVE_BINARY_HEAP_HPP
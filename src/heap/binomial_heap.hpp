@@ -2,6 +2,8 @@
 // Created by schrodinger on 19-4-9.
 //
 #include <heap_base.hpp>
+#include <node_factory.hpp>
+#include <type_traits>
 
 #ifndef DATA_STRUCTURE_FOR_LOVE_BINOMIAL_HEAP_HPP
 #define DATA_STRUCTURE_FOR_LOVE_BINOMIAL_HEAP_HPP
@@ -20,12 +22,14 @@ namespace data_structure {
     };
 
     template<typename T,
-            typename Compare = std::less<T>>
-    class BinomialHeap : public Heap<T, Compare> {
+            typename Compare = std::less<T>,
+            typename Factory = utils::PoolFactory<BinomialHeapNode<T>>>
+    class BinomialHeap : public AddressableHeap<T, Compare, BinomialHeapNode<T> *> {
         constexpr static Compare compare{};
         BinomialHeapNode<T> *root = nullptr;
         using Node = BinomialHeapNode<T>;
         std::size_t _size = 0;
+        Factory factory{};
 
         Node *link(Node *a, Node *b) noexcept;
 
@@ -56,10 +60,14 @@ namespace data_structure {
 
         Node *copy(Node *h, Node *father = nullptr);
 
+        void swap_with_father(Node *x) noexcept;
+
     public:
+        using handle = Node *;
+
         class value_holder;
 
-        void push(const T &t) override;
+        handle push(const T &t) override;
 
         value_holder push_and_hold(const T &t);
 
@@ -70,7 +78,11 @@ namespace data_structure {
         void pop() override;;
 
         template<typename ...Args>
-        void emplace(Args &&... args);
+        handle emplace(Args &&... args);
+
+        // the new nodes are counted into a heap of their own in amortized O(1) each, which is merged once
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
 
         template<typename ...Args>
         value_holder emplace_and_hold(Args &&... args);
@@ -89,14 +101,23 @@ namespace data_structure {
 
         BinomialHeap(const std::initializer_list<T> &list);
 
+        template<typename InputIt>
+        BinomialHeap(InputIt first, InputIt last);
+
         ~BinomialHeap();
 
         bool empty() override;
+
+        const T &get(handle h) override;
+
+        void decrease_key(handle h, const T &t) override;
+
+        void erase(handle h) override;
     };
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::Node *
-    BinomialHeap<T, Compare>::link(BinomialHeap::Node *a, BinomialHeap::Node *b) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::Node *
+    BinomialHeap<T, Compare, Factory>::link(BinomialHeap::Node *a, BinomialHeap::Node *b) noexcept {
         if (compare(b->value, a->value)) {
             std::swap(a, b);
         }
@@ -107,9 +128,9 @@ namespace data_structure {
         return a;
     }
 
-    template<typename T, typename Compare>
-    std::pair<typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *>
-    BinomialHeap<T, Compare>::extract_first(BinomialHeap::Node *heap) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    std::pair<typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *>
+    BinomialHeap<T, Compare, Factory>::extract_first(BinomialHeap::Node *heap) noexcept {
         Node *top = nullptr;
         if (heap) {
             top = heap;
@@ -119,9 +140,9 @@ namespace data_structure {
         return {top, heap};
     }
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::Node *
-    BinomialHeap<T, Compare>::insert_tree(BinomialHeap::Node *heap, BinomialHeap::Node *tree) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::Node *
+    BinomialHeap<T, Compare, Factory>::insert_tree(BinomialHeap::Node *heap, BinomialHeap::Node *tree) noexcept {
         while (heap and heap->rank == tree->rank) {
             auto res = extract_first(heap);
             heap = res.second;
@@ -132,9 +153,9 @@ namespace data_structure {
         return tree;
     }
 
-    template<typename T, typename Compare>
-    std::tuple<typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *>
-    BinomialHeap<T, Compare>::append_tree(BinomialHeap::Node *head, BinomialHeap::Node *prev, BinomialHeap::Node *tail,
+    template<typename T, typename Compare, typename Factory>
+    std::tuple<typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *>
+    BinomialHeap<T, Compare, Factory>::append_tree(BinomialHeap::Node *head, BinomialHeap::Node *prev, BinomialHeap::Node *tail,
                                           BinomialHeap::Node *x) noexcept {
         if (!head) return {x, nullptr, x};
         if (tail->rank == x->rank) {
@@ -149,23 +170,23 @@ namespace data_structure {
         return {head, prev, tail};
     }
 
-    template<typename T, typename Compare>
-    auto BinomialHeap<T, Compare>::insert(BinomialHeap::Node *&heap, const T &t) noexcept {
-        auto temp = new Node(t);
+    template<typename T, typename Compare, typename Factory>
+    auto BinomialHeap<T, Compare, Factory>::insert(BinomialHeap::Node *&heap, const T &t) noexcept {
+        auto temp = factory.construct(t);
         return insert_tree(heap, temp);
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename BinomialHeap<T, Compare>::Node *
-    BinomialHeap<T, Compare>::emplace(BinomialHeap::Node *&heap, Args &&... args) {
-        auto temp = new Node(std::forward<Args>(args)...);
+    typename BinomialHeap<T, Compare, Factory>::Node *
+    BinomialHeap<T, Compare, Factory>::emplace(BinomialHeap::Node *&heap, Args &&... args) {
+        auto temp = factory.construct(std::forward<Args>(args)...);
         return insert_tree(heap, temp);
     }
 
-    template<typename T, typename Compare>
-    std::tuple<typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *>
-    BinomialHeap<T, Compare>::append_trees(BinomialHeap::Node *h, BinomialHeap::Node *p, BinomialHeap::Node *t,
+    template<typename T, typename Compare, typename Factory>
+    std::tuple<typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *>
+    BinomialHeap<T, Compare, Factory>::append_trees(BinomialHeap::Node *h, BinomialHeap::Node *p, BinomialHeap::Node *t,
                                            BinomialHeap::Node *xs) noexcept {
         while (xs) {
             auto temp = extract_first(xs);
@@ -178,9 +199,9 @@ namespace data_structure {
         return {h, p, t};
     }
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::Node *
-    BinomialHeap<T, Compare>::merge(BinomialHeap::Node *h1, BinomialHeap::Node *h2) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::Node *
+    BinomialHeap<T, Compare, Factory>::merge(BinomialHeap::Node *h1, BinomialHeap::Node *h2) noexcept {
         if (!h1) return h2;
         if (!h2) return h1;
         Node *h{}, *p{}, *t{};
@@ -219,21 +240,22 @@ namespace data_structure {
         return h;
     }
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::BinomialHeap::Node *BinomialHeap<T, Compare>::reverse(BinomialHeap::Node *h) {
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::BinomialHeap::Node *BinomialHeap<T, Compare, Factory>::reverse(BinomialHeap::Node *h) {
         Node *prev = nullptr;
         while (h) {
             auto x = h;
             h = h->sibling;
             x->sibling = prev;
+            x->father = nullptr;
             prev = x;
         }
         return prev;
     }
 
-    template<typename T, typename Compare>
-    std::pair<typename BinomialHeap<T, Compare>::Node *, typename BinomialHeap<T, Compare>::Node *>
-    BinomialHeap<T, Compare>::remove_min_tree(BinomialHeap::Node *h) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    std::pair<typename BinomialHeap<T, Compare, Factory>::Node *, typename BinomialHeap<T, Compare, Factory>::Node *>
+    BinomialHeap<T, Compare, Factory>::remove_min_tree(BinomialHeap::Node *h) noexcept {
         Node *head = h,
                 *prev_min = nullptr,
                 *min_t = nullptr,
@@ -255,8 +277,8 @@ namespace data_structure {
         return {min_t, head};
     }
 
-    template<typename T, typename Compare>
-    const T &BinomialHeap<T, Compare>::top(BinomialHeap::Node *h) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    const T &BinomialHeap<T, Compare, Factory>::top(BinomialHeap::Node *h) noexcept {
         Node *min_t = nullptr;
         while (h) {
             if (!min_t || compare(h->value, min_t->value)) min_t = h;
@@ -265,172 +287,235 @@ namespace data_structure {
         return min_t->value;
     }
 
-    template<typename T, typename Compare>
-    std::pair<T, typename BinomialHeap<T, Compare>::Node *>
-    BinomialHeap<T, Compare>::pop(BinomialHeap::Node *h) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    std::pair<T, typename BinomialHeap<T, Compare, Factory>::Node *>
+    BinomialHeap<T, Compare, Factory>::pop(BinomialHeap::Node *h) noexcept {
         auto temp = remove_min_tree(h);
         h = merge(temp.second, reverse(temp.first->child));
         temp.first->child = nullptr;
         std::pair<T, Node *> res = {temp.first->value, h};
-        delete (temp.first);
+        factory.destroy(temp.first);
         return res;
     }
 
-    template<typename T, typename Compare>
-    void BinomialHeap<T, Compare>::destroy(BinomialHeap::Node *h) {
-        if (!h) return;
-        else {
-            destroy(h->sibling);
-            destroy(h->child);
-            delete (h);
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::destroy(BinomialHeap::Node *h) {
+        // a node with children is put behind its first child, which is taken out of its list: the trees are
+        // flattened into one list without recursion
+        while (h) {
+            if (auto c = h->child) {
+                h->child = c->sibling;
+                c->sibling = h;
+                h = c;
+            } else {
+                auto next = h->sibling;
+                factory.destroy(h);
+                h = next;
+            }
         }
     }
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::Node *
-    BinomialHeap<T, Compare>::copy(BinomialHeap::Node *h, BinomialHeap::Node *father) {
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::Node *
+    BinomialHeap<T, Compare, Factory>::copy(BinomialHeap::Node *h, BinomialHeap::Node *father) {
         if (!h)
             return nullptr;
-        auto m = new Node(h->value);
+        auto m = factory.construct(h->value);
         m->rank = h->rank;
         m->father = father;
         m->sibling = copy(h->sibling, father);
-        m->child = copy(h->child, h);
+        m->child = copy(h->child, m);
         return m;
     }
 
-    template<typename T, typename Compare>
-    class BinomialHeap<T, Compare>::value_holder {
+    /*
+     * Exchange a node with its father, moving the nodes rather than the values so that handles stay attached to
+     * their elements: x takes the place, rank and children of its father, the father takes those of x.
+     * The singly linked sibling lists and father pointers make it O(rank) instead of O(1).
+     */
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::swap_with_father(Node *x) noexcept {
+        auto p = x->father;
+        auto pl = p->father ? &p->father->child : &root;
+        while (*pl != p) pl = &(*pl)->sibling;
+        auto xl = &p->child;
+        while (*xl != x) xl = &(*xl)->sibling;
+        auto x_child = x->child, x_sibling = x->sibling;
+        auto x_rank = x->rank;
+        *xl = p;
+        x->child = p->child;
+        x->sibling = p->sibling;
+        x->father = p->father;
+        x->rank = p->rank;
+        *pl = x;
+        p->child = x_child;
+        p->sibling = x_sibling;
+        p->rank = x_rank;
+        for (auto c = x->child; c; c = c->sibling) c->father = x;
+        for (auto c = p->child; c; c = c->sibling) c->father = p;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    class BinomialHeap<T, Compare, Factory>::value_holder {
         Node *node;
+        BinomialHeap *heap;
     public:
-        value_holder(Node *node) : node(node) {}
+        value_holder(Node *node, BinomialHeap *heap) : node(node), heap(heap) {}
 
         const auto &get() {
             return node->value;
         }
 
         void re_push(const T &value) {
-            node->value = value;
-            auto p = node->father;
-            while (p && compare(node->value, p->value)) {
-                std::swap(node->value, p->value);
-                node = p;
-                p = p->father;
-            }
+            heap->decrease_key(node, value);
         }
 
         template<typename ...Args>
         void re_emplace(Args &&... args) {
-            node->value = T(std::forward<Args>(args)...);
-            auto p = node->father;
-            while (p && compare(node->value, p->value)) {
-                std::swap(node->value, p->value);
-                node = p;
-                p = p->father;
-            }
+            heap->decrease_key(node, T(std::forward<Args>(args)...));
         }
     };
 
-    template<typename T, typename Compare>
-    void BinomialHeap<T, Compare>::push(const T &t) {
-        root = insert(root, t);
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::handle BinomialHeap<T, Compare, Factory>::push(const T &t) {
         _size++;
+        auto temp = factory.construct(t);
+        root = insert_tree(root, temp);
+        return temp;
     }
 
-    template<typename T, typename Compare>
-    typename BinomialHeap<T, Compare>::value_holder BinomialHeap<T, Compare>::push_and_hold(const T &t) {
-        _size++;
-        auto temp = new Node(t);
-        root = insert_tree(root, temp);
-        return {temp};
+    template<typename T, typename Compare, typename Factory>
+    typename BinomialHeap<T, Compare, Factory>::value_holder BinomialHeap<T, Compare, Factory>::push_and_hold(const T &t) {
+        return {push(t), this};
     }
 
-    template<typename T, typename Compare>
-    const T &BinomialHeap<T, Compare>::top() {
+    template<typename T, typename Compare, typename Factory>
+    const T &BinomialHeap<T, Compare, Factory>::top() {
         return top(root);
     }
 
-    template<typename T, typename Compare>
-    size_t BinomialHeap<T, Compare>::size() const {
+    template<typename T, typename Compare, typename Factory>
+    size_t BinomialHeap<T, Compare, Factory>::size() const {
         return _size;
     }
 
-    template<typename T, typename Compare>
-    void BinomialHeap<T, Compare>::pop() {
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::pop() {
         root = pop(root).second;
         _size--;
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    void BinomialHeap<T, Compare>::emplace(Args &&... args) {
-        root = emplace(root, std::forward<Args>(args)...);
+    typename BinomialHeap<T, Compare, Factory>::handle BinomialHeap<T, Compare, Factory>::emplace(Args &&... args) {
         _size++;
+        auto temp = factory.construct(std::forward<Args>(args)...);
+        root = insert_tree(root, temp);
+        return temp;
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename BinomialHeap<T, Compare>::value_holder BinomialHeap<T, Compare>::emplace_and_hold(Args &&... args) {
-        _size++;
-        auto temp = new Node(std::forward<Args>(args)...);
-        root = insert_tree(root, temp);
-        return {temp};
+    typename BinomialHeap<T, Compare, Factory>::value_holder BinomialHeap<T, Compare, Factory>::emplace_and_hold(Args &&... args) {
+        return {emplace(std::forward<Args>(args)...), this};
     }
 
-    template<typename T, typename Compare>
-    void BinomialHeap<T, Compare>::merge(BinomialHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::merge(BinomialHeap &that) {
+        static_assert(Factory::meldable, "the nodes of the other heap must be taken over by this factory");
+        factory.absorb(that.factory);
         root = merge(root, that.root);
         that.root = nullptr;
         _size += that.size();
+        that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare>::BinomialHeap(const BinomialHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory>::BinomialHeap(const BinomialHeap &that) {
         root = copy(that.root);
         _size = that.size();
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare> &BinomialHeap<T, Compare>::operator=(const BinomialHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory> &BinomialHeap<T, Compare, Factory>::operator=(const BinomialHeap &that) {
         destroy(root);
         root = copy(that.root);
         _size = that.size();
         return *this;
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare>::BinomialHeap(BinomialHeap &&that) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory>::BinomialHeap(BinomialHeap &&that) noexcept : factory(std::move(that.factory)) {
         root = that.root;
         that.root = nullptr;
         _size = that.size();
         that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare> &BinomialHeap<T, Compare>::operator=(BinomialHeap &&that) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory> &BinomialHeap<T, Compare, Factory>::operator=(BinomialHeap &&that) noexcept {
         destroy(root);
         root = that.root;
         that.root = nullptr;
         _size = that.size();
         that._size = 0;
+        std::swap(factory, that.factory);
         return *this;
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare>::BinomialHeap(const std::initializer_list<T> &list) {
-        for (const auto &i: list) {
-            this->push(i);
-        }
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory>::BinomialHeap(const std::initializer_list<T> &list) {
+        push_range(list.begin(), list.end());
     }
 
-    template<typename T, typename Compare>
-    BinomialHeap<T, Compare>::~BinomialHeap() {
-        destroy(root);
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    BinomialHeap<T, Compare, Factory>::BinomialHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    void BinomialHeap<T, Compare, Factory>::push_range(InputIt first, InputIt last) {
+        Node *h = nullptr;
+        size_t k = 0;
+        for (; first != last; ++first, ++k) h = insert_tree(h, factory.construct(*first));
+        root = merge(root, h);
+        _size += k;
     }
 
-    template<typename T, typename Compare>
-    bool BinomialHeap<T, Compare>::empty() {
+    template<typename T, typename Compare, typename Factory>
+    BinomialHeap<T, Compare, Factory>::~BinomialHeap() {
+        // the pool hands its chunks back at once, the trees only need a walk to run the destructors of the values
+        if constexpr (!Factory::bulk_release || !std::is_trivially_destructible_v<T>) destroy(root);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    bool BinomialHeap<T, Compare, Factory>::empty() {
         return !root;
     }
+
+    template<typename T, typename Compare, typename Factory>
+    const T &BinomialHeap<T, Compare, Factory>::get(handle h) {
+        return h->value;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::decrease_key(handle h, const T &t) {
+        h->value = t;
+        while (h->father && compare(h->value, h->father->value)) swap_with_father(h);
+    }
+
+    // lift the node to the root of its tree whatever its value is, then remove it as pop removes a minimum
+    template<typename T, typename Compare, typename Factory>
+    void BinomialHeap<T, Compare, Factory>::erase(handle h) {
+        while (h->father) swap_with_father(h);
+        auto l = &root;
+        while (*l != h) l = &(*l)->sibling;
+        *l = h->sibling;
+        root = merge(root, reverse(h->child));
+        factory.destroy(h);
+        _size--;
+    }
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_BINOMIAL_HEAP_HPP
@@ -0,0 +1,234 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_DARY_HEAP_HPP
+#define DATA_STRUCTURE_FOR_LOVE_DARY_HEAP_HPP
+
+#include <heap_base.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace data_structure {
+    /*
+     * Implicit heap in which every node has D children, D fixed at compile time. A pop looks at D children per
+     * level but only descends log_D(N) levels, and as the children of a node are adjacent, scanning them costs one
+     * cache miss instead of one per child.
+     * The array is aligned to a cache line and the root is stored at slot D - 1 of it, so the children of node i,
+     * nodes D * i + 1 ... D * i + D, start on slot D * (i + 1): when D * sizeof(T) divides 64 (D = 4 or 8 for
+     * 8 byte keys, D = 16 for ints) a sibling group never straddles two cache lines.
+     */
+    template<typename T, size_t D = 4, typename Compare = std::less<T>>
+    class DaryHeap : public Heap<T, Compare> {
+        static_assert(D >= 2, "a heap node needs at least two children");
+
+        constexpr static Compare compare{};
+        constexpr static size_t alignment = std::max<size_t>(64, alignof(T));
+
+        T *buffer = nullptr; // D - 1 unused slots, then the elements
+        size_t n = 0, capacity = 0;
+
+        T *data() const noexcept { return buffer + (D - 1); }
+
+        void reallocate(size_t new_capacity);
+
+        void sift_up(size_t i);
+
+        void sift_down(size_t i);
+
+        void heapify();
+
+    public:
+        DaryHeap() = default;
+
+        DaryHeap(const std::initializer_list<T> &list);
+
+        // O(n) bulk construction
+        template<typename InputIt>
+        DaryHeap(InputIt first, InputIt last);
+
+        DaryHeap(const DaryHeap &that);
+
+        DaryHeap(DaryHeap &&that) noexcept;
+
+        DaryHeap &operator=(DaryHeap that) noexcept;
+
+        ~DaryHeap();
+
+        void push(const T &t) override;
+
+        void push(T &&t);
+
+        template<typename ...Args>
+        void emplace(Args &&...args);
+
+        // inserts all elements of the range, with one bottom-up heapify when they outnumber the present ones
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
+        size_t size() const override;
+
+        const T &top() override;
+
+        void pop() override;
+
+        bool empty() override;
+
+        void reserve(size_t n);
+
+        void clear() noexcept;
+    };
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::reallocate(size_t new_capacity) {
+        auto fresh = static_cast<T *>(::operator new((new_capacity + D - 1) * sizeof(T),
+                                                     std::align_val_t(alignment))) + (D - 1);
+        for (size_t i = 0; i < n; ++i) {
+            new(fresh + i) T(std::move_if_noexcept(data()[i]));
+            data()[i].~T();
+        }
+        if (buffer) ::operator delete(buffer, std::align_val_t(alignment));
+        buffer = fresh - (D - 1);
+        capacity = new_capacity;
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::sift_up(size_t i) {
+        auto a = data();
+        T value = std::move(a[i]);
+        while (i) {
+            auto father = (i - 1) / D;
+            if (!compare(value, a[father])) break;
+            a[i] = std::move(a[father]);
+            i = father;
+        }
+        a[i] = std::move(value);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::sift_down(size_t i) {
+        auto a = data();
+        T value = std::move(a[i]);
+        for (auto first = D * i + 1; first < n; first = D * i + 1) {
+            auto best = first, last = std::min(first + D, n);
+            for (auto child = first + 1; child < last; ++child) {
+                if (compare(a[child], a[best])) best = child;
+            }
+            if (!compare(a[best], value)) break;
+            a[i] = std::move(a[best]);
+            i = best;
+        }
+        a[i] = std::move(value);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::heapify() {
+        if (n < 2) return;
+        for (auto i = (n - 2) / D + 1; i-- > 0;) sift_down(i);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    DaryHeap<T, D, Compare>::DaryHeap(const std::initializer_list<T> &list)
+            : DaryHeap(list.begin(), list.end()) {}
+
+    template<typename T, size_t D, typename Compare>
+    template<typename InputIt>
+    DaryHeap<T, D, Compare>::DaryHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    DaryHeap<T, D, Compare>::DaryHeap(const DaryHeap &that) {
+        reserve(that.n);
+        for (; n < that.n; ++n) new(data() + n) T(that.data()[n]);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    DaryHeap<T, D, Compare>::DaryHeap(DaryHeap &&that) noexcept
+            : buffer(that.buffer), n(that.n), capacity(that.capacity) {
+        that.buffer = nullptr;
+        that.n = that.capacity = 0;
+    }
+
+    template<typename T, size_t D, typename Compare>
+    DaryHeap<T, D, Compare> &DaryHeap<T, D, Compare>::operator=(DaryHeap that) noexcept {
+        std::swap(buffer, that.buffer);
+        std::swap(n, that.n);
+        std::swap(capacity, that.capacity);
+        return *this;
+    }
+
+    template<typename T, size_t D, typename Compare>
+    DaryHeap<T, D, Compare>::~DaryHeap() {
+        clear();
+        if (buffer) ::operator delete(buffer, std::align_val_t(alignment));
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::push(const T &t) {
+        emplace(t);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::push(T &&t) {
+        emplace(std::move(t));
+    }
+
+    template<typename T, size_t D, typename Compare>
+    template<typename... Args>
+    void DaryHeap<T, D, Compare>::emplace(Args &&... args) {
+        if (n == capacity) reallocate(std::max<size_t>(16, capacity * 2));
+        new(data() + n) T(std::forward<Args>(args)...);
+        sift_up(n++);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    template<typename InputIt>
+    void DaryHeap<T, D, Compare>::push_range(InputIt first, InputIt last) {
+        auto old = n;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category>) {
+            reserve(n + std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            if (n == capacity) reallocate(std::max<size_t>(16, capacity * 2));
+            new(data() + n) T(*first);
+            ++n;
+        }
+        if (n - old > old) heapify();
+        else for (auto i = old; i < n; ++i) sift_up(i);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    size_t DaryHeap<T, D, Compare>::size() const { return n; }
+
+    template<typename T, size_t D, typename Compare>
+    const T &DaryHeap<T, D, Compare>::top() { return data()[0]; }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::pop() {
+        if (!n) return;
+        auto a = data();
+        if (--n) a[0] = std::move(a[n]);
+        a[n].~T();
+        if (n > 1) sift_down(0);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    bool DaryHeap<T, D, Compare>::empty() {
+        return !n;
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::reserve(size_t m) {
+        if (m > capacity) reallocate(m);
+    }
+
+    template<typename T, size_t D, typename Compare>
+    void DaryHeap<T, D, Compare>::clear() noexcept {
+        for (size_t i = 0; i < n; ++i) data()[i].~T();
+        n = 0;
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_DARY_HEAP_HPP
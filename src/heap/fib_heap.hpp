@@ -6,7 +6,11 @@
 #define DATA_STRUCTURE_FOR_LOVE_FIB_HEAP_HPP
 
 #include <heap_base.hpp>
+#include <node_factory.hpp>
+#include <type_traits>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace data_structure {
     template<typename T>
@@ -23,15 +27,19 @@ namespace data_structure {
     };
 
     template<typename T,
-            typename Compare = std::less<T>>
-    class FibHeap : public Heap<T, Compare> {
+            typename Compare = std::less<T>,
+            typename Factory = utils::PoolFactory<FibHeapNode<T>>>
+    class FibHeap : public AddressableHeap<T, Compare, FibHeapNode<T> *> {
         using Node = FibHeapNode<T>;
         Node *root = nullptr;
         Node *min_tree = nullptr;
         std::size_t _size{};
+        Factory factory{};
         constexpr static Compare compare{};
+        // a node of degree k roots at least F(k + 2) >= phi^k nodes, so no degree reaches log_phi(2^64) < 93
+        constexpr static size_t max_rank = std::numeric_limits<size_t>::digits * 3 / 2;
 
-        void destroy_tree(Node *x);
+        void destroy(Node *first);
 
         Node *concat(Node *first1, Node *first2);
 
@@ -45,8 +53,6 @@ namespace data_structure {
 
         Node *link(Node *x, Node *y);
 
-        size_t max_degree(size_t n);
-
         void consolidate();
 
         void cut(Node *x);
@@ -55,6 +61,8 @@ namespace data_structure {
 
 
     public:
+        using handle = Node *;
+
         class value_holder;
 
         bool is_empty();
@@ -65,6 +73,9 @@ namespace data_structure {
 
         FibHeap(const std::initializer_list<T> &list);
 
+        template<typename InputIt>
+        FibHeap(InputIt first, InputIt last);
+
         FibHeap(FibHeap &&that) noexcept;
 
         FibHeap &operator=(FibHeap &&that) noexcept;
@@ -73,10 +84,14 @@ namespace data_structure {
 
         FibHeap &operator=(const FibHeap &that) = delete;
 
-        void push(const T &t) override;
+        handle push(const T &t) override;
 
         template<typename ...Args>
-        void emplace(Args &&...args);
+        handle emplace(Args &&...args);
+
+        // the new nodes form one ring that is spliced into the root list, consolidation is left to the next pop
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
 
         value_holder push_and_hold(const T &t);
 
@@ -93,25 +108,26 @@ namespace data_structure {
 
         bool empty() override;
 
+        const T &get(handle h) override;
+
+        void decrease_key(handle h, const T &t) override;
+
+        void erase(handle h) override;
     };
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::destroy_tree(FibHeap::Node *x) {
-        if (!x) return;
-        Node *y{}, *z{};
-        if (x->children) {
-            y = x->children;
-            do {
-                z = y;
-                y = y->next;
-                destroy_tree(z);
-            } while (y != x->children);
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::destroy(FibHeap::Node *first) {
+        // the children of every destroyed node are spliced into the ring still to destroy, so there is no recursion
+        while (first) {
+            auto x = first;
+            first = remove_node(first, x);
+            if (x->children) first = first ? concat(first, x->children) : x->children;
+            factory.destroy(x);
         }
-        delete x;
     }
 
-    template<typename T, typename Compare>
-    typename FibHeap<T, Compare>::Node *FibHeap<T, Compare>::concat(FibHeap::Node *first1, FibHeap::Node *first2) {
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::Node *FibHeap<T, Compare, Factory>::concat(FibHeap::Node *first1, FibHeap::Node *first2) {
         Node *last1 = first1->prev;
         Node *last2 = first2->prev;
         last1->next = first2;
@@ -121,8 +137,8 @@ namespace data_structure {
         return first1;
     }
 
-    template<typename T, typename Compare>
-    typename FibHeap<T, Compare>::Node *FibHeap<T, Compare>::append(FibHeap::Node *first, FibHeap::Node *x) {
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::Node *FibHeap<T, Compare, Factory>::append(FibHeap::Node *first, FibHeap::Node *x) {
         if (!first) {
             return x;
         }
@@ -134,8 +150,8 @@ namespace data_structure {
         return first;
     }
 
-    template<typename T, typename Compare>
-    typename FibHeap<T, Compare>::Node *FibHeap<T, Compare>::remove_node(FibHeap::Node *first, FibHeap::Node *x) {
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::Node *FibHeap<T, Compare, Factory>::remove_node(FibHeap::Node *first, FibHeap::Node *x) {
         Node *p, *n;
         if (x->next == x && first == x)
             first = nullptr;
@@ -152,21 +168,21 @@ namespace data_structure {
         return first;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::add_tree(FibHeap::Node *t) {
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::add_tree(FibHeap::Node *t) {
         root = append(root, t);
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::insert(FibHeap::Node *x) {
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::insert(FibHeap::Node *x) {
         add_tree(x);
         if (!min_tree || compare(x->value, min_tree->value))
             min_tree = x;
         _size++;
     }
 
-    template<typename T, typename Compare>
-    typename FibHeap<T, Compare>::Node *FibHeap<T, Compare>::link(FibHeap::Node *x, FibHeap::Node *y) {
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::Node *FibHeap<T, Compare, Factory>::link(FibHeap::Node *x, FibHeap::Node *y) {
         if (compare(y->value, x->value)) std::swap(x, y);
         x->children = append(x->children, y);
         y->parent = x;
@@ -175,26 +191,15 @@ namespace data_structure {
         return x;
     }
 
-    template<typename T, typename Compare>
-    size_t FibHeap<T, Compare>::max_degree(size_t n) {
-        size_t k{}, F{}, F2{}, F1 = 1;
-        for (F = F1 + F2, k = 2; F < n; ++k) {
-            F2 = F1;
-            F1 = F;
-            F = F1 + F2;
-        }
-        return k - 2;
-    }
-
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::consolidate() {
-        if (!this->root)
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::consolidate() {
+        if (!this->root) {
+            this->min_tree = nullptr;
             return;
-        size_t D = max_degree(this->_size) + 1;
+        }
+        Node *a[max_rank]{};
         Node *x, *y;
-        Node **a = new Node *[D + 1];
-        size_t i, d;
-        std::fill(a, a + D + 1, nullptr);
+        size_t i, d, D = 0;
         while (this->root) {
             x = this->root;
             this->root = remove_node(this->root, x);
@@ -205,6 +210,7 @@ namespace data_structure {
                 a[d++] = nullptr;
             }
             a[d] = x;
+            D = std::max(D, d);
         }
         this->min_tree = this->root = nullptr;
         for (i = 0; i <= D; ++i)
@@ -213,11 +219,10 @@ namespace data_structure {
                 if (this->min_tree == nullptr || compare(a[i]->value, this->min_tree->value))
                     this->min_tree = a[i];
             }
-        delete[] a;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::cut(FibHeap::Node *x) {
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::cut(FibHeap::Node *x) {
         Node *p = x->parent;
         p->children = remove_node(p->children, x);
         p->degree--;
@@ -226,21 +231,19 @@ namespace data_structure {
         x->mark = 0;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::cascading_cut(FibHeap::Node *x) {
-        Node *p = x->parent;
-        if (p) {
-            if (!x->mark)
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::cascading_cut(FibHeap::Node *x) {
+        for (Node *p = x->parent; p; x = p, p = x->parent) {
+            if (!x->mark) {
                 x->mark = 1;
-            else {
-                cut(x);
-                cascading_cut(p);
+                break;
             }
+            cut(x);
         }
     }
 
-    template<typename T, typename Compare>
-    class FibHeap<T, Compare>::value_holder {
+    template<typename T, typename Compare, typename Factory>
+    class FibHeap<T, Compare, Factory>::value_holder {
         Node *node;
         FibHeap *heap;
     public:
@@ -251,52 +254,53 @@ namespace data_structure {
         }
 
         void re_push(const T &value) {
-            node->value = value;
-            auto p = node->parent;
-            if (p && compare(value, p->value)) {
-                heap->cut(node);
-                heap->cascading_cut(p);
-            }
-            if (compare(value, heap->min_tree->value)) heap->min_tree = node;
+            heap->decrease_key(node, value);
         }
 
         template<typename ...Args>
         void re_emplace(Args &&... args) {
-            node->value = T(std::forward<Args>(args)...);
-            auto p = node->parent;
-            if (p && compare(node->value, p->value)) {
-                heap->cut(node);
-                heap->cascading_cut(p);
-            }
-            if (compare(node->value, heap->min_tree->value)) heap->min_tree = node;
+            heap->decrease_key(node, T(std::forward<Args>(args)...));
         }
     };
 
-    template<typename T, typename Compare>
-    bool FibHeap<T, Compare>::is_empty() { return root == nullptr; }
-
-    template<typename T, typename Compare>
-    FibHeap<T, Compare>::~FibHeap() {
-        Node *x{}, *y{};
-        if (root) {
-            x = root;
-            do {
-                y = x;
-                x = x->next;
-                destroy_tree(y);
-            } while (x != root);
-        }
+    template<typename T, typename Compare, typename Factory>
+    bool FibHeap<T, Compare, Factory>::is_empty() { return root == nullptr; }
+
+    template<typename T, typename Compare, typename Factory>
+    FibHeap<T, Compare, Factory>::~FibHeap() {
+        // the pool hands its chunks back at once, the trees only need a walk to run the destructors of the values
+        if constexpr (!Factory::bulk_release || !std::is_trivially_destructible_v<T>) destroy(root);
     }
 
-    template<typename T, typename Compare>
-    FibHeap<T, Compare>::FibHeap(const std::initializer_list<T> &list) {
-        for (const auto &i : list) {
-            push(i);
+    template<typename T, typename Compare, typename Factory>
+    FibHeap<T, Compare, Factory>::FibHeap(const std::initializer_list<T> &list) {
+        push_range(list.begin(), list.end());
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    FibHeap<T, Compare, Factory>::FibHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    void FibHeap<T, Compare, Factory>::push_range(InputIt first, InputIt last) {
+        Node *ring = nullptr, *best = min_tree;
+        size_t k = 0;
+        for (; first != last; ++first, ++k) {
+            auto x = factory.construct(*first);
+            ring = append(ring, x);
+            if (!best || compare(x->value, best->value)) best = x;
         }
+        if (!ring) return;
+        root = root ? concat(root, ring) : ring;
+        min_tree = best;
+        _size += k;
     }
 
-    template<typename T, typename Compare>
-    FibHeap<T, Compare>::FibHeap(FibHeap &&that) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    FibHeap<T, Compare, Factory>::FibHeap(FibHeap &&that) noexcept : factory(std::move(that.factory)) {
         this->min_tree = that.min_tree;
         this->root = that.root;
         this->_size = that._size;
@@ -304,50 +308,57 @@ namespace data_structure {
         that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    FibHeap<T, Compare> &FibHeap<T, Compare>::operator=(FibHeap &&that) noexcept {
-        this->~FibHeap();
+    template<typename T, typename Compare, typename Factory>
+    FibHeap<T, Compare, Factory> &FibHeap<T, Compare, Factory>::operator=(FibHeap &&that) noexcept {
+        destroy(root);
         this->min_tree = that.min_tree;
         this->root = that.root;
         this->_size = that._size;
         that.min_tree = that.root = nullptr;
         that._size = 0;
+        std::swap(factory, that.factory);
         return *this;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::push(const T &t) {
-        insert(new Node(t));
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::handle FibHeap<T, Compare, Factory>::push(const T &t) {
+        auto m = factory.construct(t);
+        insert(m);
+        return m;
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    void FibHeap<T, Compare>::emplace(Args &&... args) {
-        insert(new Node(std::forward<Args>(args)...));
+    typename FibHeap<T, Compare, Factory>::handle FibHeap<T, Compare, Factory>::emplace(Args &&... args) {
+        auto m = factory.construct(std::forward<Args>(args)...);
+        insert(m);
+        return m;
     }
 
-    template<typename T, typename Compare>
-    typename FibHeap<T, Compare>::value_holder FibHeap<T, Compare>::push_and_hold(const T &t) {
-        auto m = new Node(t);
+    template<typename T, typename Compare, typename Factory>
+    typename FibHeap<T, Compare, Factory>::value_holder FibHeap<T, Compare, Factory>::push_and_hold(const T &t) {
+        auto m = factory.construct(t);
         insert(m);
         return {m, this};
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename FibHeap<T, Compare>::value_holder FibHeap<T, Compare>::emplace_and_hold(Args &&... args) {
-        auto m = new Node(std::forward<Args>(args)...);
+    typename FibHeap<T, Compare, Factory>::value_holder FibHeap<T, Compare, Factory>::emplace_and_hold(Args &&... args) {
+        auto m = factory.construct(std::forward<Args>(args)...);
         insert(m);
         return {m, this};
     }
 
-    template<typename T, typename Compare>
-    const T &FibHeap<T, Compare>::top() {
+    template<typename T, typename Compare, typename Factory>
+    const T &FibHeap<T, Compare, Factory>::top() {
         return min_tree->value;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::merge(FibHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::merge(FibHeap &that) {
+        static_assert(Factory::meldable, "the nodes of the other heap must be taken over by this factory");
+        factory.absorb(that.factory);
         if (is_empty()) {
             this->root = that.root;
             this->min_tree = that.min_tree;
@@ -364,8 +375,8 @@ namespace data_structure {
         that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    void FibHeap<T, Compare>::pop() {
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::pop() {
         Node *x = this->min_tree;
         Node *y, *child;
         if (x) {
@@ -381,19 +392,46 @@ namespace data_structure {
             this->root = remove_node(this->root, x);
             this->_size--;
             consolidate();
-            delete (x);
+            factory.destroy(x);
         }
     }
 
-    template<typename T, typename Compare>
-    std::size_t FibHeap<T, Compare>::size() const {
+    template<typename T, typename Compare, typename Factory>
+    std::size_t FibHeap<T, Compare, Factory>::size() const {
         return _size;
     }
 
-    template<typename T, typename Compare>
-    bool FibHeap<T, Compare>::empty() {
+    template<typename T, typename Compare, typename Factory>
+    bool FibHeap<T, Compare, Factory>::empty() {
         return !root;
     }
 
+    template<typename T, typename Compare, typename Factory>
+    const T &FibHeap<T, Compare, Factory>::get(handle h) {
+        return h->value;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::decrease_key(handle h, const T &t) {
+        h->value = t;
+        auto p = h->parent;
+        if (p && compare(t, p->value)) {
+            cut(h);
+            cascading_cut(p);
+        }
+        if (compare(h->value, min_tree->value)) min_tree = h;
+    }
+
+    // cut the node out as if its key became minus infinity, then pop it
+    template<typename T, typename Compare, typename Factory>
+    void FibHeap<T, Compare, Factory>::erase(handle h) {
+        if (auto p = h->parent) {
+            cut(h);
+            cascading_cut(p);
+        }
+        min_tree = h;
+        pop();
+    }
+
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_FIB_HEAP_HPP
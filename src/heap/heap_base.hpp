@@ -19,5 +19,29 @@ namespace data_structure {
         virtual bool empty() = 0;
     };
 
+    /*
+     * Heaps whose elements stay addressable after insertion. push returns a handle that is valid until its element
+     * leaves the heap through pop or erase (afterwards the heap may reuse it). decrease_key replaces the value of an
+     * element with one that does not compare worse and moves it towards the top; erase removes an element wherever
+     * it is. Graph algorithms written against this interface work with every addressable heap.
+     */
+    template<typename T, typename Compare, typename Handle>
+    class AddressableHeap {
+    public:
+        using handle = Handle;
+
+        virtual const T &top() = 0;
+        virtual Handle push(const T& t) = 0;
+
+        virtual size_t size() const = 0;
+        virtual void pop() = 0;
+
+        virtual bool empty() = 0;
+
+        virtual const T &get(Handle h) = 0;
+        virtual void decrease_key(Handle h, const T& t) = 0;
+        virtual void erase(Handle h) = 0;
+    };
+
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_HEAP_BASE_HPP
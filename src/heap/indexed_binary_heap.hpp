@@ -0,0 +1,220 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_INDEXED_BINARY_HEAP_HPP
+#define DATA_STRUCTURE_FOR_LOVE_INDEXED_BINARY_HEAP_HPP
+
+#include <heap_base.hpp>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace data_structure {
+    /*
+     * Addressable implicit binary heap. Elements live in one array as in BinaryHeap, each tagged with the id
+     * returned by push; a second array maps every id to the current index of its element and is updated whenever
+     * a sift moves an element. Ids of elements that left the heap are recycled.
+     */
+    template<typename T, typename Compare = std::less<T>>
+    class IndexedBinaryHeap : public AddressableHeap<T, Compare, size_t> {
+        constexpr static Compare compare{};
+        constexpr static size_t npos = static_cast<size_t>(-1);
+
+        struct Entry {
+            T value;
+            size_t id;
+        };
+
+        std::vector<Entry> data;
+        std::vector<size_t> position; // id -> index into data, or the next free id
+        size_t free_list = npos;
+
+        void place(size_t i, Entry &&entry);
+
+        void sift_up(size_t i);
+
+        void sift_down(size_t i);
+
+        void heapify();
+
+        size_t acquire(size_t index);
+
+        void release(size_t id);
+
+        void remove_at(size_t i);
+
+    public:
+        using handle = size_t;
+
+        IndexedBinaryHeap() = default;
+
+        // O(n) bulk construction, the ids are 0 ... n - 1 in the order of the range
+        template<typename InputIt>
+        IndexedBinaryHeap(InputIt first, InputIt last);
+
+        handle push(const T &t) override;
+
+        template<typename ...Args>
+        handle emplace(Args &&...args);
+
+        // ids are handed out in the order of the range, as consecutive pushes would do
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
+        size_t size() const override;
+
+        const T &top() override;
+
+        void pop() override;
+
+        bool empty() override;
+
+        const T &get(handle h) override;
+
+        void decrease_key(handle h, const T &t) override;
+
+        void erase(handle h) override;
+
+        void reserve(size_t n);
+    };
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::place(size_t i, Entry &&entry) {
+        position[entry.id] = i;
+        data[i] = std::move(entry);
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::sift_up(size_t i) {
+        Entry entry = std::move(data[i]);
+        while (i) {
+            auto father = (i - 1) >> 1u;
+            if (!compare(entry.value, data[father].value)) break;
+            place(i, std::move(data[father]));
+            i = father;
+        }
+        place(i, std::move(entry));
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::sift_down(size_t i) {
+        auto n = data.size();
+        Entry entry = std::move(data[i]);
+        for (auto child = 2 * i + 1; child < n; child = 2 * i + 1) {
+            if (child + 1 < n && compare(data[child + 1].value, data[child].value)) ++child;
+            if (!compare(data[child].value, entry.value)) break;
+            place(i, std::move(data[child]));
+            i = child;
+        }
+        place(i, std::move(entry));
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::heapify() {
+        for (auto i = data.size() / 2; i-- > 0;) sift_down(i);
+    }
+
+    template<typename T, typename Compare>
+    size_t IndexedBinaryHeap<T, Compare>::acquire(size_t index) {
+        if (free_list == npos) {
+            position.push_back(index);
+            return position.size() - 1;
+        }
+        auto id = free_list;
+        free_list = position[id];
+        position[id] = index;
+        return id;
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::release(size_t id) {
+        position[id] = free_list;
+        free_list = id;
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::remove_at(size_t i) {
+        release(data[i].id);
+        auto last = data.size() - 1;
+        if (i != last) place(i, std::move(data[last]));
+        data.pop_back();
+        if (i == last) return;
+        if (i && compare(data[i].value, data[(i - 1) >> 1u].value)) sift_up(i);
+        else sift_down(i);
+    }
+
+    template<typename T, typename Compare>
+    typename IndexedBinaryHeap<T, Compare>::handle IndexedBinaryHeap<T, Compare>::push(const T &t) {
+        return emplace(t);
+    }
+
+    template<typename T, typename Compare>
+    template<typename... Args>
+    typename IndexedBinaryHeap<T, Compare>::handle IndexedBinaryHeap<T, Compare>::emplace(Args &&... args) {
+        auto id = acquire(data.size());
+        data.push_back({T(std::forward<Args>(args)...), id});
+        sift_up(data.size() - 1);
+        return id;
+    }
+
+    template<typename T, typename Compare>
+    template<typename InputIt>
+    IndexedBinaryHeap<T, Compare>::IndexedBinaryHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare>
+    template<typename InputIt>
+    void IndexedBinaryHeap<T, Compare>::push_range(InputIt first, InputIt last) {
+        auto old = data.size();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<InputIt>::iterator_category>) {
+            reserve(old + std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            auto id = acquire(data.size());
+            data.push_back({T(*first), id});
+        }
+        if (data.size() - old > old) heapify();
+        else for (auto i = old; i < data.size(); ++i) sift_up(i);
+    }
+
+    template<typename T, typename Compare>
+    size_t IndexedBinaryHeap<T, Compare>::size() const { return data.size(); }
+
+    template<typename T, typename Compare>
+    const T &IndexedBinaryHeap<T, Compare>::top() { return data.front().value; }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::pop() {
+        if (!data.empty()) remove_at(0);
+    }
+
+    template<typename T, typename Compare>
+    bool IndexedBinaryHeap<T, Compare>::empty() {
+        return data.empty();
+    }
+
+    template<typename T, typename Compare>
+    const T &IndexedBinaryHeap<T, Compare>::get(handle h) {
+        return data[position[h]].value;
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::decrease_key(handle h, const T &t) {
+        auto i = position[h];
+        data[i].value = t;
+        sift_up(i);
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::erase(handle h) {
+        remove_at(position[h]);
+    }
+
+    template<typename T, typename Compare>
+    void IndexedBinaryHeap<T, Compare>::reserve(size_t n) {
+        data.reserve(n);
+        position.reserve(n);
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_INDEXED_BINARY_HEAP_HPP
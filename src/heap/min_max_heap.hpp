@@ -0,0 +1,255 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_MIN_MAX_HEAP_HPP
+#define DATA_STRUCTURE_FOR_LOVE_MIN_MAX_HEAP_HPP
+
+#include <heap_base.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace data_structure {
+    /*
+     * Double ended priority queue as a min-max heap (Atkinson et al.): an implicit binary tree in one array whose
+     * even levels, the root's included, are ordered like a min-heap and whose odd levels like a max-heap, so that
+     * every element is no greater than its descendants on a min level and no smaller on a max level. The minimum is
+     * the root and the maximum one of its two children. A sift compares an element with its grandparents or
+     * grandchildren and so descends two levels per step; elements move into a hole instead of being swapped.
+     * As a Heap it is the min-heap of Compare: top and pop are top_min and pop_min.
+     */
+    template<typename T,
+            typename Compare = std::less<T>,
+            typename Alloc = std::allocator<T>>
+    class MinMaxHeap : public Heap<T, Compare> {
+        constexpr static Compare compare{};
+
+        std::vector<T, Alloc> data;
+
+        static bool min_level(size_t i) noexcept {
+            return !((std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(i + 1)) & 1u);
+        }
+
+        // on a max level the order is reversed
+        template<bool Max>
+        static bool before(const T &a, const T &b) { return Max ? compare(b, a) : compare(a, b); }
+
+        template<bool Max>
+        void sift_up(size_t i, T value);
+
+        void sift_up(size_t i);
+
+        template<bool Max>
+        void sift_down(size_t i);
+
+        void sift_down(size_t i);
+
+        void heapify();
+
+        size_t max_index() const noexcept;
+
+        void remove_at(size_t i);
+
+    public:
+        MinMaxHeap() = default;
+
+        MinMaxHeap(const std::initializer_list<T> &list);
+
+        // O(n) bulk construction
+        template<typename InputIt>
+        MinMaxHeap(InputIt first, InputIt last);
+
+        explicit MinMaxHeap(std::vector<T, Alloc> values);
+
+        void push(const T &t) override;
+
+        void push(T &&t);
+
+        template<typename ...Args>
+        void emplace(Args &&...args);
+
+        // inserts all elements of the range, with one bottom-up heapify when they outnumber the present ones
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
+        size_t size() const override;
+
+        const T &top() override;
+
+        void pop() override;
+
+        bool empty() override;
+
+        const T &top_min() const;
+
+        const T &top_max() const;
+
+        void pop_min();
+
+        void pop_max();
+
+        void reserve(size_t n);
+    };
+
+    template<typename T, typename Compare, typename Alloc>
+    template<bool Max>
+    void MinMaxHeap<T, Compare, Alloc>::sift_up(size_t i, T value) {
+        // i > 2 has a grandparent, on a level of the same kind
+        while (i > 2) {
+            auto grandparent = (((i - 1) >> 1u) - 1) >> 1u;
+            if (!before<Max>(value, data[grandparent])) break;
+            data[i] = std::move(data[grandparent]);
+            i = grandparent;
+        }
+        data[i] = std::move(value);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::sift_up(size_t i) {
+        if (!i) return;
+        T value = std::move(data[i]);
+        auto father = (i - 1) >> 1u;
+        // an element beyond its father belongs to the father's kind of level
+        if (min_level(i)) {
+            if (compare(data[father], value)) {
+                data[i] = std::move(data[father]);
+                sift_up<true>(father, std::move(value));
+            } else sift_up<false>(i, std::move(value));
+        } else {
+            if (compare(value, data[father])) {
+                data[i] = std::move(data[father]);
+                sift_up<false>(father, std::move(value));
+            } else sift_up<true>(i, std::move(value));
+        }
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<bool Max>
+    void MinMaxHeap<T, Compare, Alloc>::sift_down(size_t i) {
+        auto n = data.size();
+        T value = std::move(data[i]);
+        for (;;) {
+            auto child = 2 * i + 1;
+            if (child >= n) break;
+            // the best of the children and grandchildren
+            auto best = child;
+            if (child + 1 < n && before<Max>(data[child + 1], data[best])) best = child + 1;
+            for (auto g = 2 * child + 1, last = std::min(g + 4, n); g < last; ++g) {
+                if (before<Max>(data[g], data[best])) best = g;
+            }
+            if (!before<Max>(data[best], value)) break;
+            data[i] = std::move(data[best]);
+            i = best;
+            if (best <= child + 1) break;
+            // a grandchild moved up: the value may have to trade places with the father of the hole
+            auto father = (i - 1) >> 1u;
+            if (before<Max>(data[father], value)) std::swap(data[father], value);
+        }
+        data[i] = std::move(value);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::sift_down(size_t i) {
+        if (min_level(i)) sift_down<false>(i);
+        else sift_down<true>(i);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::heapify() {
+        for (auto i = data.size() / 2; i-- > 0;) sift_down(i);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    size_t MinMaxHeap<T, Compare, Alloc>::max_index() const noexcept {
+        if (data.size() < 3) return data.size() - 1;
+        return compare(data[1], data[2]) ? 2 : 1;
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::remove_at(size_t i) {
+        if (i + 1 < data.size()) data[i] = std::move(data.back());
+        data.pop_back();
+        if (i < data.size()) sift_down(i);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    MinMaxHeap<T, Compare, Alloc>::MinMaxHeap(const std::initializer_list<T> &list) : data(list) {
+        heapify();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<typename InputIt>
+    MinMaxHeap<T, Compare, Alloc>::MinMaxHeap(InputIt first, InputIt last) : data(first, last) {
+        heapify();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    MinMaxHeap<T, Compare, Alloc>::MinMaxHeap(std::vector<T, Alloc> values) : data(std::move(values)) {
+        heapify();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::push(const T &t) {
+        data.push_back(t);
+        sift_up(data.size() - 1);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::push(T &&t) {
+        data.push_back(std::move(t));
+        sift_up(data.size() - 1);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<typename... Args>
+    void MinMaxHeap<T, Compare, Alloc>::emplace(Args &&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
+        sift_up(data.size() - 1);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    template<typename InputIt>
+    void MinMaxHeap<T, Compare, Alloc>::push_range(InputIt first, InputIt last) {
+        auto old = data.size();
+        data.insert(data.end(), first, last);
+        if (data.size() - old > old) heapify();
+        else for (auto i = old; i < data.size(); ++i) sift_up(i);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    size_t MinMaxHeap<T, Compare, Alloc>::size() const { return data.size(); }
+
+    template<typename T, typename Compare, typename Alloc>
+    const T &MinMaxHeap<T, Compare, Alloc>::top() { return top_min(); }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::pop() { pop_min(); }
+
+    template<typename T, typename Compare, typename Alloc>
+    bool MinMaxHeap<T, Compare, Alloc>::empty() {
+        return data.empty();
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    const T &MinMaxHeap<T, Compare, Alloc>::top_min() const { return data.front(); }
+
+    template<typename T, typename Compare, typename Alloc>
+    const T &MinMaxHeap<T, Compare, Alloc>::top_max() const { return data[max_index()]; }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::pop_min() {
+        if (!data.empty()) remove_at(0);
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::pop_max() {
+        if (!data.empty()) remove_at(max_index());
+    }
+
+    template<typename T, typename Compare, typename Alloc>
+    void MinMaxHeap<T, Compare, Alloc>::reserve(size_t n) {
+        data.reserve(n);
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_MIN_MAX_HEAP_HPP
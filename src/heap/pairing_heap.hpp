@@ -2,6 +2,8 @@
 // Created by schrodinger on 19-4-9.
 //
 #include <heap_base.hpp>
+#include <node_factory.hpp>
+#include <type_traits>
 
 #ifndef DATA_STRUCTURE_FOR_LOVE_PAIRING_HEAP_HPP
 #define DATA_STRUCTURE_FOR_LOVE_PAIRING_HEAP_HPP
@@ -18,15 +20,16 @@ namespace data_structure {
     };
 
     template<typename T,
-            typename Compare = std::less<T>>
-    class PairingHeap : public Heap<T, Compare> {
+            typename Compare = std::less<T>,
+            typename Factory = utils::PoolFactory<PairingHeapNode<T>>>
+    class PairingHeap : public AddressableHeap<T, Compare, PairingHeapNode<T> *> {
         using Node = PairingHeapNode<T>;
 
         constexpr static Compare compare{};
 
-        static void destroy(Node *h) noexcept;
+        void destroy(Node *h) noexcept;
 
-        static Node *copy(Node *node, Node *parent = nullptr);
+        Node *copy(Node *node, Node *parent = nullptr);
 
         static Node *push_front(Node *list, Node *x) noexcept;
 
@@ -34,10 +37,10 @@ namespace data_structure {
 
         static Node *merge(Node *h1, Node *h2) noexcept;
 
-        static Node *push(Node *h, const T &x) noexcept;
+        Node *push(Node *h, const T &x) noexcept;
 
         template<typename ...Args>
-        static Node *emplace(Node *h, Args &&...args) noexcept;
+        Node *emplace(Node *h, Args &&...args) noexcept;
 
         static const T &top(Node *h) noexcept;
 
@@ -47,11 +50,13 @@ namespace data_structure {
         template<typename ...Args>
         static Node *emplace_decreased_key(Node *h, Node *x, Args &&...args) noexcept;
 
-        static Node *pop(Node *h) noexcept;
+        Node *pop(Node *h) noexcept;
 
         Node *root = nullptr;
         size_t _size = 0;
+        Factory factory{};
     public:
+        using handle = Node *;
 
         class value_holder;
 
@@ -59,6 +64,9 @@ namespace data_structure {
 
         PairingHeap(const std::initializer_list<T> &list);
 
+        template<typename InputIt>
+        PairingHeap(InputIt first, InputIt last);
+
         PairingHeap(PairingHeap &&that) noexcept;
 
         PairingHeap &operator=(PairingHeap &&that) noexcept;
@@ -72,10 +80,17 @@ namespace data_structure {
 
         const T &top() override;
 
-        void push(const T &t) override;
+        handle push(const T &t) override;
 
         template<typename ...Args>
-        void emplace(Args &&... args) noexcept;
+        handle emplace(Args &&... args) noexcept;
+
+        /*
+         * The new nodes are merged pairwise in rounds, like a tournament, into a tree of depth lg k that is then
+         * merged with the root. Pushing them one by one would leave k children under the root for the next pop.
+         */
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
 
         void merge(PairingHeap &that);
 
@@ -93,42 +108,68 @@ namespace data_structure {
 
         bool empty() override;
 
+        const T &get(handle h) override;
+
+        void decrease_key(handle h, const T &t) override;
+
+        void erase(handle h) override;
     };
 
-    template<typename T, typename Compare>
-    void PairingHeap<T, Compare>::destroy(PairingHeap::Node *h) noexcept {
-        Node *t = nullptr;
-        if (h) {
-            while ((t = h->children)) {
-                h->children = h->children->next;
-                destroy(t);
+    template<typename T, typename Compare, typename Factory>
+    void PairingHeap<T, Compare, Factory>::destroy(PairingHeap::Node *h) noexcept {
+        // a node with children is put behind its first child, which is taken out of its list: the trees are
+        // flattened into one list without recursion, whatever their depth
+        while (h) {
+            if (auto c = h->children) {
+                h->children = c->next;
+                c->next = h;
+                h = c;
+            } else {
+                auto next = h->next;
+                factory.destroy(h);
+                h = next;
             }
         }
-        delete h;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::copy(PairingHeap::Node *node, PairingHeap::Node *parent) {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::copy(PairingHeap::Node *node, PairingHeap::Node *parent) {
         if (!node)
             return nullptr;
-        auto p = new Node(node->value);
-        p->parent = parent;
-        if (node->children) p->children = copy(node->children, p);
-        if (node->next) p->next = copy(node->next);
-        return p;
+        // walk the source tree in preorder along the parent pointers, building the copy in lockstep
+        auto res = factory.construct(node->value);
+        res->parent = parent;
+        for (auto s = node, d = res;;) {
+            Node *father = d;
+            if (s->children) {
+                s = s->children;
+                d = d->children = factory.construct(s->value);
+            } else {
+                while (s != node && !s->next) {
+                    s = s->parent;
+                    d = d->parent;
+                }
+                if (s == node) break;
+                s = s->next;
+                father = d->parent;
+                d = d->next = factory.construct(s->value);
+            }
+            d->parent = father;
+        }
+        return res;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::push_front(PairingHeap::Node *list, PairingHeap::Node *x) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::push_front(PairingHeap::Node *list, PairingHeap::Node *x) noexcept {
         x->next = list;
         return x;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::remove_node(PairingHeap::Node *list, PairingHeap::Node *x) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::remove_node(PairingHeap::Node *list, PairingHeap::Node *x) noexcept {
         auto p = list;
         if (x == list) return x->next;
         while (p && p->next != x) p = p->next;
@@ -136,9 +177,9 @@ namespace data_structure {
         return list;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::merge(PairingHeap::Node *h1, PairingHeap::Node *h2) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::merge(PairingHeap::Node *h1, PairingHeap::Node *h2) noexcept {
         if (!h1) return h2;
         if (!h2) return h1;
         if (compare(h2->value, h1->value)) std::swap(h1, h2);
@@ -146,29 +187,30 @@ namespace data_structure {
         h1->children = h2;
         h2->parent = h1;
         h1->next = nullptr;
+        h1->parent = nullptr;
         return h1;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *PairingHeap<T, Compare>::push(PairingHeap::Node *h, const T &x) noexcept {
-        return merge(h, new Node(x));
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *PairingHeap<T, Compare, Factory>::push(PairingHeap::Node *h, const T &x) noexcept {
+        return merge(h, factory.construct(x));
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::emplace(PairingHeap::Node *h, Args &&... args) noexcept {
-        return merge(h, new Node(std::forward<Args>(args)...));
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::emplace(PairingHeap::Node *h, Args &&... args) noexcept {
+        return merge(h, factory.construct(std::forward<Args>(args)...));
     }
 
-    template<typename T, typename Compare>
-    const T &PairingHeap<T, Compare>::top(PairingHeap::Node *h) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    const T &PairingHeap<T, Compare, Factory>::top(PairingHeap::Node *h) noexcept {
         return h->value;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::push_decreased_key(PairingHeap::Node *h, PairingHeap::Node *x, const T &key) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::push_decreased_key(PairingHeap::Node *h, PairingHeap::Node *x, const T &key) noexcept {
         x->value = key;
         if (x->parent) {
             x->parent->children = remove_node(x->parent->children, x);
@@ -178,10 +220,10 @@ namespace data_structure {
         return h;
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename PairingHeap<T, Compare>::Node *
-    PairingHeap<T, Compare>::emplace_decreased_key(PairingHeap::Node *h, PairingHeap::Node *x,
+    typename PairingHeap<T, Compare, Factory>::Node *
+    PairingHeap<T, Compare, Factory>::emplace_decreased_key(PairingHeap::Node *h, PairingHeap::Node *x,
                                                    Args &&... args) noexcept {
         x->value = T(std::forward<Args>(args)...);
         if (x->parent) {
@@ -192,9 +234,11 @@ namespace data_structure {
         return h;
     }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::Node *PairingHeap<T, Compare>::pop(PairingHeap::Node *h) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::Node *PairingHeap<T, Compare, Factory>::pop(PairingHeap::Node *h) noexcept {
         Node *x{}, *y{}, *list{};
+        // two-pass pairing without recursion: pair the children left to right onto a stack threaded through
+        // `next`, then merge the pairs right to left
         while ((x = h->children)) {
             if ((h->children = y = x->next))
                 h->children = h->children->next;
@@ -205,12 +249,13 @@ namespace data_structure {
             list = list->next;
             x = merge(x, y);
         }
-        delete h;
+        if (x) x->parent = x->next = nullptr;
+        factory.destroy(h);
         return x;
     }
 
-    template<typename T, typename Compare>
-    class PairingHeap<T, Compare>::value_holder {
+    template<typename T, typename Compare, typename Factory>
+    class PairingHeap<T, Compare, Factory>::value_holder {
         Node *node;
         PairingHeap *heap;
     public:
@@ -221,7 +266,7 @@ namespace data_structure {
         }
 
         void re_push(const T &value) {
-            heap->root = push_decreased_key(heap->root, node, value);
+            heap->decrease_key(node, value);
         }
 
         template<typename ...Args>
@@ -230,110 +275,168 @@ namespace data_structure {
         }
     };
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare>::PairingHeap(const std::initializer_list<T> &list) {
-        for (const auto &i : list) {
-            push(i);
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory>::PairingHeap(const std::initializer_list<T> &list) {
+        push_range(list.begin(), list.end());
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    PairingHeap<T, Compare, Factory>::PairingHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    void PairingHeap<T, Compare, Factory>::push_range(InputIt first, InputIt last) {
+        Node *list = nullptr, **tail = &list;
+        size_t k = 0;
+        for (; first != last; ++first, ++k) {
+            *tail = factory.construct(*first);
+            tail = &(*tail)->next;
         }
+        while (list && list->next) {
+            Node *winners = nullptr, **out = &winners;
+            while (list) {
+                auto x = list, y = list->next;
+                list = y ? y->next : nullptr;
+                *out = merge(x, y);
+                out = &(*out)->next;
+            }
+            list = winners;
+        }
+        root = merge(root, list);
+        _size += k;
     }
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare>::PairingHeap(PairingHeap &&that) noexcept {
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory>::PairingHeap(PairingHeap &&that) noexcept : factory(std::move(that.factory)) {
         this->root = that.root;
         this->_size = that._size;
         that.root = nullptr;
         that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare> &PairingHeap<T, Compare>::operator=(PairingHeap &&that) noexcept {
-        this->~PairingHeap();
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory> &PairingHeap<T, Compare, Factory>::operator=(PairingHeap &&that) noexcept {
+        destroy(root);
         this->root = that.root;
         this->_size = that._size;
         that.root = nullptr;
         that._size = 0;
+        std::swap(factory, that.factory);
         return *this;
     }
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare>::PairingHeap(const PairingHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory>::PairingHeap(const PairingHeap &that) {
         this->root = copy(that.root);
         this->_size = that._size;
     }
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare> &PairingHeap<T, Compare>::operator=(const PairingHeap &that) {
-        this->~PairingHeap();
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory> &PairingHeap<T, Compare, Factory>::operator=(const PairingHeap &that) {
+        destroy(root);
         this->root = copy(that.root);
         this->_size = that._size;
         return *this;
     }
 
-    template<typename T, typename Compare>
-    PairingHeap<T, Compare>::~PairingHeap() {
-        destroy(root);
+    template<typename T, typename Compare, typename Factory>
+    PairingHeap<T, Compare, Factory>::~PairingHeap() {
+        // the pool hands its chunks back at once, the trees only need a walk to run the destructors of the values
+        if constexpr (!Factory::bulk_release || !std::is_trivially_destructible_v<T>) destroy(root);
     }
 
-    template<typename T, typename Compare>
-    const T &PairingHeap<T, Compare>::top() {
+    template<typename T, typename Compare, typename Factory>
+    const T &PairingHeap<T, Compare, Factory>::top() {
         return top(root);
     }
 
-    template<typename T, typename Compare>
-    void PairingHeap<T, Compare>::push(const T &t) {
-        root = push(root, t);
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::handle PairingHeap<T, Compare, Factory>::push(const T &t) {
+        auto m = factory.construct(t);
+        root = merge(root, m);
         _size += 1;
+        return m;
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    void PairingHeap<T, Compare>::emplace(Args &&... args) noexcept {
-        root = emplace(root, std::forward<Args>(args)...);
+    typename PairingHeap<T, Compare, Factory>::handle PairingHeap<T, Compare, Factory>::emplace(Args &&... args) noexcept {
+        auto m = factory.construct(std::forward<Args>(args)...);
+        root = merge(root, m);
         _size += 1;
+        return m;
     }
 
-    template<typename T, typename Compare>
-    void PairingHeap<T, Compare>::merge(PairingHeap &that) {
+    template<typename T, typename Compare, typename Factory>
+    void PairingHeap<T, Compare, Factory>::merge(PairingHeap &that) {
+        static_assert(Factory::meldable, "the nodes of the other heap must be taken over by this factory");
+        factory.absorb(that.factory);
         root = merge(root, that.root);
         that.root = nullptr;
         _size += that._size;
         that._size = 0;
     }
 
-    template<typename T, typename Compare>
-    size_t PairingHeap<T, Compare>::size() const {
+    template<typename T, typename Compare, typename Factory>
+    size_t PairingHeap<T, Compare, Factory>::size() const {
         return _size;
     }
 
-    template<typename T, typename Compare>
-    void PairingHeap<T, Compare>::pop() {
+    template<typename T, typename Compare, typename Factory>
+    void PairingHeap<T, Compare, Factory>::pop() {
         root = pop(root);
         _size -= 1;
     }
 
-    template<typename T, typename Compare>
-    bool PairingHeap<T, Compare>::is_empty() { return root == nullptr; }
+    template<typename T, typename Compare, typename Factory>
+    bool PairingHeap<T, Compare, Factory>::is_empty() { return root == nullptr; }
 
-    template<typename T, typename Compare>
-    typename PairingHeap<T, Compare>::value_holder PairingHeap<T, Compare>::push_and_hold(const T &t) {
-        auto m = new Node(t);
+    template<typename T, typename Compare, typename Factory>
+    typename PairingHeap<T, Compare, Factory>::value_holder PairingHeap<T, Compare, Factory>::push_and_hold(const T &t) {
+        auto m = factory.construct(t);
         root = merge(root, m);
         _size += 1;
         return {m, this};
     }
 
-    template<typename T, typename Compare>
+    template<typename T, typename Compare, typename Factory>
     template<typename... Args>
-    typename PairingHeap<T, Compare>::value_holder PairingHeap<T, Compare>::emplace_and_hold(Args &&... args) {
-        auto m = new Node(std::forward<Args>(args)...);
+    typename PairingHeap<T, Compare, Factory>::value_holder PairingHeap<T, Compare, Factory>::emplace_and_hold(Args &&... args) {
+        auto m = factory.construct(std::forward<Args>(args)...);
         root = merge(root, m);
         _size += 1;
         return {m, this};
     }
 
-    template<typename T, typename Compare>
-    bool PairingHeap<T, Compare>::empty() {
+    template<typename T, typename Compare, typename Factory>
+    bool PairingHeap<T, Compare, Factory>::empty() {
         return !root;
     }
+
+    template<typename T, typename Compare, typename Factory>
+    const T &PairingHeap<T, Compare, Factory>::get(handle h) {
+        return h->value;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void PairingHeap<T, Compare, Factory>::decrease_key(handle h, const T &t) {
+        root = push_decreased_key(root, h, t);
+    }
+
+    // detach the subtree, pair up its children as pop does and merge the result back
+    template<typename T, typename Compare, typename Factory>
+    void PairingHeap<T, Compare, Factory>::erase(handle h) {
+        if (h->parent) {
+            h->parent->children = remove_node(h->parent->children, h);
+            h->parent = nullptr;
+            root = merge(root, pop(h));
+        } else {
+            root = pop(h);
+        }
+        _size -= 1;
+    }
 }
 #endif //DATA_STRUCTURE_FOR_LOVE_PAIRING_HEAP_HPP
@@ -0,0 +1,252 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_PERSISTENT_LEFTIST_HEAP_HPP
+#define DATA_STRUCTURE_FOR_LOVE_PERSISTENT_LEFTIST_HEAP_HPP
+
+#include <heap_base.hpp>
+#include <node_factory.hpp>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace data_structure {
+    template<typename T>
+    struct LeftistNode {
+        LeftistNode *left{}, *right{};
+        size_t count = 1; // heaps and parent nodes referring to this node
+        size_t rank = 1;  // length of the right spine
+        T value;
+
+        template<typename ...Args>
+        explicit LeftistNode(Args &&...args): value(std::forward<Args>(args)...) {}
+    };
+
+    /*
+     * Persistent leftist heap. Every node keeps the length of its right spine, never longer than that of its left
+     * child, so the right spine of a heap of n elements has at most lg(n + 1) nodes and two heaps are melded by
+     * merging their right spines. Nodes are reference counted and never changed once shared: copying a heap only
+     * shares its root, and push, pop and merge copy the O(lg n) nodes of the spines they walk down when those are
+     * shared with another heap, but change nodes owned by this heap alone in place, so a heap that is never copied
+     * works like an ordinary leftist heap.
+     * Unlike a skew heap, whose bounds are amortized and do not survive persistence, the bounds are worst case.
+     * The reference counts are not atomic: heaps sharing nodes must stay in one thread. As the nodes move between
+     * heaps, they come from a stateless Factory.
+     */
+    template<typename T,
+            typename Compare = std::less<T>,
+            typename Factory = utils::TrivialFactory<LeftistNode<T>>>
+    class PersistentLeftistHeap : public Heap<T, Compare> {
+        static_assert(std::is_empty_v<Factory>, "nodes shared between heaps need a stateless factory");
+
+        using Node = LeftistNode<T>;
+
+        constexpr static Compare compare{};
+
+        static size_t rank(Node *h) noexcept { return h ? h->rank : 0; }
+
+        static Node *acquire(Node *h) noexcept;
+
+        static void release(Node *h) noexcept;
+
+        // melds two heaps whose references are handed over
+        static Node *meld(Node *a, Node *b);
+
+        Node *root = nullptr;
+        size_t _size = 0;
+
+    public:
+        PersistentLeftistHeap() = default;
+
+        PersistentLeftistHeap(const std::initializer_list<T> &list);
+
+        // O(n) bulk construction
+        template<typename InputIt>
+        PersistentLeftistHeap(InputIt first, InputIt last);
+
+        // O(1), the two heaps share all their nodes
+        PersistentLeftistHeap(const PersistentLeftistHeap &that) noexcept;
+
+        PersistentLeftistHeap(PersistentLeftistHeap &&that) noexcept;
+
+        PersistentLeftistHeap &operator=(const PersistentLeftistHeap &that) noexcept;
+
+        PersistentLeftistHeap &operator=(PersistentLeftistHeap &&that) noexcept;
+
+        ~PersistentLeftistHeap();
+
+        void push(const T &t) override;
+
+        template<typename ...Args>
+        void emplace(Args &&...args);
+
+        // the new elements are melded pairwise in rounds into one heap, which is then melded with this one
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
+        // O(lg n); `that` is left unchanged and keeps sharing its nodes with this heap
+        void merge(const PersistentLeftistHeap &that);
+
+        size_t size() const override;
+
+        const T &top() override;
+
+        void pop() override;
+
+        bool empty() override;
+    };
+
+    template<typename T, typename Compare, typename Factory>
+    typename PersistentLeftistHeap<T, Compare, Factory>::Node *
+    PersistentLeftistHeap<T, Compare, Factory>::acquire(Node *h) noexcept {
+        if (h) h->count++;
+        return h;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void PersistentLeftistHeap<T, Compare, Factory>::release(Node *h) noexcept {
+        if (!h || --h->count) return;
+        // dead nodes wait for their left child to be released in a list threaded through their right pointers,
+        // so a long chain is freed without recursion
+        Factory factory;
+        Node *pending = nullptr;
+        for (;;) {
+            while (h) {
+                auto next = h->right;
+                h->right = pending;
+                pending = h;
+                h = next && !--next->count ? next : nullptr;
+            }
+            if (!pending) break;
+            auto dead = pending;
+            pending = dead->right;
+            auto left = dead->left;
+            factory.destroy(dead);
+            h = left && !--left->count ? left : nullptr;
+        }
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    typename PersistentLeftistHeap<T, Compare, Factory>::Node *
+    PersistentLeftistHeap<T, Compare, Factory>::meld(Node *a, Node *b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (compare(b->value, a->value)) std::swap(a, b);
+        if (a->count > 1) {
+            // shared: this heap gets its own copy of the root, referring to the same children
+            Factory factory;
+            auto copy = factory.construct(a->value);
+            copy->left = acquire(a->left);
+            copy->right = acquire(a->right);
+            copy->rank = a->rank;
+            a->count--;
+            a = copy;
+        }
+        a->right = meld(a->right, b);
+        if (rank(a->left) < rank(a->right)) std::swap(a->left, a->right);
+        a->rank = rank(a->right) + 1;
+        return a;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory>::PersistentLeftistHeap(const std::initializer_list<T> &list)
+            : PersistentLeftistHeap(list.begin(), list.end()) {}
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    PersistentLeftistHeap<T, Compare, Factory>::PersistentLeftistHeap(InputIt first, InputIt last) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory>::PersistentLeftistHeap(const PersistentLeftistHeap &that) noexcept
+            : root(acquire(that.root)), _size(that._size) {}
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory>::PersistentLeftistHeap(PersistentLeftistHeap &&that) noexcept
+            : root(that.root), _size(that._size) {
+        that.root = nullptr;
+        that._size = 0;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory> &
+    PersistentLeftistHeap<T, Compare, Factory>::operator=(const PersistentLeftistHeap &that) noexcept {
+        auto old = root;
+        root = acquire(that.root);
+        _size = that._size;
+        release(old);
+        return *this;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory> &
+    PersistentLeftistHeap<T, Compare, Factory>::operator=(PersistentLeftistHeap &&that) noexcept {
+        std::swap(root, that.root);
+        std::swap(_size, that._size);
+        return *this;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    PersistentLeftistHeap<T, Compare, Factory>::~PersistentLeftistHeap() {
+        release(root);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void PersistentLeftistHeap<T, Compare, Factory>::push(const T &t) {
+        emplace(t);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename... Args>
+    void PersistentLeftistHeap<T, Compare, Factory>::emplace(Args &&... args) {
+        Factory factory;
+        root = meld(root, factory.construct(std::forward<Args>(args)...));
+        _size++;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    template<typename InputIt>
+    void PersistentLeftistHeap<T, Compare, Factory>::push_range(InputIt first, InputIt last) {
+        Factory factory;
+        std::vector<Node *> heaps;
+        for (; first != last; ++first) heaps.push_back(factory.construct(*first));
+        _size += heaps.size();
+        while (heaps.size() > 1) {
+            size_t k = 0;
+            for (size_t i = 0; i + 1 < heaps.size(); i += 2) heaps[k++] = meld(heaps[i], heaps[i + 1]);
+            if (heaps.size() & 1u) heaps[k++] = heaps.back();
+            heaps.resize(k);
+        }
+        if (!heaps.empty()) root = meld(root, heaps.front());
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    void PersistentLeftistHeap<T, Compare, Factory>::merge(const PersistentLeftistHeap &that) {
+        // acquired first, so that merging a heap with itself sees its nodes shared
+        auto other = acquire(that.root);
+        _size += that._size;
+        root = meld(root, other);
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    size_t PersistentLeftistHeap<T, Compare, Factory>::size() const { return _size; }
+
+    template<typename T, typename Compare, typename Factory>
+    const T &PersistentLeftistHeap<T, Compare, Factory>::top() { return root->value; }
+
+    template<typename T, typename Compare, typename Factory>
+    void PersistentLeftistHeap<T, Compare, Factory>::pop() {
+        if (!root) return;
+        auto old = root;
+        auto left = acquire(old->left), right = acquire(old->right);
+        release(old);
+        root = meld(left, right);
+        _size--;
+    }
+
+    template<typename T, typename Compare, typename Factory>
+    bool PersistentLeftistHeap<T, Compare, Factory>::empty() {
+        return !root;
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_PERSISTENT_LEFTIST_HEAP_HPP
@@ -0,0 +1,165 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_RADIX_HEAP_HPP
+#define DATA_STRUCTURE_FOR_LOVE_RADIX_HEAP_HPP
+
+#include <heap_base.hpp>
+#include <integer_set_base.hpp>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace data_structure {
+    /*
+     * Monotone min-heap of unsigned keys carrying a value: a pushed key must not be smaller than the last popped one,
+     * as in Dijkstra's algorithm or an event simulation. Elements are kept in max_bit(Key) + 1 buckets by the highest
+     * bit in which their key differs from the last popped key, bucket 0 holding the keys equal to it. When bucket 0
+     * runs empty, pop redistributes the first non empty bucket around its minimum, which moves every element to a
+     * strictly lower bucket, so each element is moved at most max_bit(Key) times and no key is ever compared with
+     * another one except to find that minimum. top only locates the minimum, as the buckets must stay relative to the
+     * last popped key until the minimum is actually popped.
+     * Elements with equal keys are popped in no particular order.
+     */
+    template<typename Key, typename Value>
+    class RadixHeap : public Heap<std::pair<Key, Value>> {
+        static_assert(std::is_unsigned_v<Key> && sizeof(Key) <= sizeof(unsigned long long),
+                      "radix heap keys are unsigned integers of at most 64 bits");
+
+        using Entry = std::pair<Key, Value>;
+
+        constexpr static size_t bits = max_bit(std::numeric_limits<Key>::max());
+
+        std::array<std::vector<Entry>, bits + 1> buckets{};
+        Key last = 0;
+        size_t n = 0;
+        // where the minimum is, once located, until it is popped; min_bucket is bits + 1 while it is unknown
+        size_t min_bucket = bits + 1, min_index = 0;
+
+        static size_t bucket_of(Key key, Key last) noexcept;
+
+        // find the minimum without moving any element
+        void locate();
+
+    public:
+        using key_type = Key;
+        using value_type = Value;
+
+        void push(const Entry &t) override;
+
+        void push(Key key, Value value);
+
+        template<typename ...Args>
+        void emplace(Key key, Args &&...args);
+
+        size_t size() const override;
+
+        const Entry &top() override;
+
+        void pop() override;
+
+        bool empty() override;
+
+        // the key of the last popped element, no smaller key may be pushed any more
+        Key last_key() const noexcept;
+
+        void clear() noexcept;
+    };
+
+    template<typename Key, typename Value>
+    size_t RadixHeap<Key, Value>::bucket_of(Key key, Key last) noexcept {
+        auto diff = static_cast<unsigned long long>(key ^ last);
+        return diff ? std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff) : 0;
+    }
+
+    template<typename Key, typename Value>
+    void RadixHeap<Key, Value>::locate() {
+        if (min_bucket <= bits) return;
+        if (!buckets[0].empty()) {
+            min_bucket = 0;
+            min_index = buckets[0].size() - 1;
+            return;
+        }
+        size_t i = 1;
+        while (buckets[i].empty()) ++i;
+        auto &from = buckets[i];
+        min_bucket = i;
+        min_index = 0;
+        for (size_t j = 1; j < from.size(); ++j) if (from[j].first < from[min_index].first) min_index = j;
+    }
+
+    template<typename Key, typename Value>
+    void RadixHeap<Key, Value>::push(const Entry &t) {
+        emplace(t.first, t.second);
+    }
+
+    template<typename Key, typename Value>
+    void RadixHeap<Key, Value>::push(Key key, Value value) {
+        emplace(key, std::move(value));
+    }
+
+    template<typename Key, typename Value>
+    template<typename... Args>
+    void RadixHeap<Key, Value>::emplace(Key key, Args &&... args) {
+        assert(key >= last && "keys pushed into a radix heap must not be smaller than the last popped one");
+        auto i = bucket_of(key, last);
+        buckets[i].emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+        ++n;
+        if (min_bucket <= bits && key < buckets[min_bucket][min_index].first) {
+            min_bucket = i;
+            min_index = buckets[i].size() - 1;
+        }
+    }
+
+    template<typename Key, typename Value>
+    size_t RadixHeap<Key, Value>::size() const { return n; }
+
+    template<typename Key, typename Value>
+    const typename RadixHeap<Key, Value>::Entry &RadixHeap<Key, Value>::top() {
+        locate();
+        return buckets[min_bucket][min_index];
+    }
+
+    template<typename Key, typename Value>
+    void RadixHeap<Key, Value>::pop() {
+        if (!n) return;
+        locate();
+        auto &zero = buckets[0];
+        if (min_bucket) {
+            // the popped key becomes the base: every element of the bucket moves to a lower one, the minimum to 0,
+            // and the located entry last, so it is the one popped among equal keys
+            auto &from = buckets[min_bucket];
+            last = from[min_index].first;
+            for (size_t j = 0; j < from.size(); ++j) {
+                if (j != min_index) buckets[bucket_of(from[j].first, last)].push_back(std::move(from[j]));
+            }
+            zero.push_back(std::move(from[min_index]));
+            from.clear();
+        } else if (min_index + 1 != zero.size()) std::swap(zero[min_index], zero.back());
+        zero.pop_back();
+        min_bucket = bits + 1;
+        --n;
+    }
+
+    template<typename Key, typename Value>
+    bool RadixHeap<Key, Value>::empty() {
+        return !n;
+    }
+
+    template<typename Key, typename Value>
+    Key RadixHeap<Key, Value>::last_key() const noexcept {
+        return last;
+    }
+
+    template<typename Key, typename Value>
+    void RadixHeap<Key, Value>::clear() noexcept {
+        for (auto &i : buckets) i.clear();
+        last = 0;
+        n = 0;
+        min_bucket = bits + 1;
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_RADIX_HEAP_HPP
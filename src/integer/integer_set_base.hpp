@@ -8,6 +8,7 @@
 #include <utility>
 #include <cstddef>
 #include <optional>
+#include <limits>
 namespace data_structure {
 
     template<class Int>
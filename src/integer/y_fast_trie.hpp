@@ -297,6 +297,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     bool YFastTrie<Int, bit, HASH_BUILDER>::contains(Int t) const {
+        if (dummy.links[1] == &dummy) return false;
         auto leaf = locate(t);
         return (leaf && leaf->treap) ? leaf->treap->contains(t) : false;
 //            for (auto i : *this) {
@@ -307,7 +308,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     void YFastTrie<Int, bit, HASH_BUILDER>::insert(Int t) {
-        if (!n) {
+        if (dummy.links[1] == &dummy) {
             x_insert(top, new YTreap<Int>);
         }
         auto tree = locate(t)->treap;
@@ -324,6 +325,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     std::optional<Int> YFastTrie<Int, bit, HASH_BUILDER>::pred(Int t) const {
+        if (dummy.links[1] == &dummy) return std::nullopt;
         auto leaf = locate(t);
         if (leaf) {
             auto q = leaf->treap->pred(t);
@@ -337,6 +339,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     std::optional<Int> YFastTrie<Int, bit, HASH_BUILDER>::succ(Int t) const {
+        if (dummy.links[1] == &dummy) return std::nullopt;
         auto leaf = locate(t);
         if (leaf) {
             auto q = leaf->treap->succ(t);
@@ -366,6 +369,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     void YFastTrie<Int, bit, HASH_BUILDER>::erase(Int t) {
+        if (dummy.links[1] == &dummy) return;
         Leaf *leaf = locate(t);
         bool flag = leaf->treap->erase(t);
         if (flag) {
@@ -383,10 +387,28 @@ namespace data_structure {
         const Leaf *leaf;
         typename YTreap<Int>::TNode *node;
 
-        explicit const_iterator(const Leaf *leaf) : leaf(leaf), node(leaf->treap->min_node(leaf->treap->root)) {}
+        explicit const_iterator(const Leaf *leaf)
+                : leaf(leaf), node(leaf->treap ? leaf->treap->min_node(leaf->treap->root) : nullptr) {
+            skip_forward();
+        }
 
         explicit const_iterator(const Leaf *leaf, typename YTreap<Int>::TNode *node) : leaf(leaf), node(node) {}
 
+        // leaves may hold empty treaps (the top leaf often does); the dummy leaf, which has none, ends the walk
+        void skip_forward() {
+            while (!node && leaf && leaf->treap) {
+                leaf = static_cast<Leaf *>(leaf->links[1]);
+                if (leaf && leaf->treap) node = leaf->treap->min_node(leaf->treap->root);
+            }
+        }
+
+        void skip_backward() {
+            while (!node && leaf && leaf->treap) {
+                leaf = static_cast<Leaf *>(leaf->links[0]);
+                if (leaf && leaf->treap) node = leaf->treap->max_node(leaf->treap->root);
+            }
+        }
+
     public:
 
         Int operator*() const {
@@ -396,11 +418,7 @@ namespace data_structure {
         const_iterator &operator++() {
             if (leaf) {
                 node = YTreap<Int>::succ(node);
-                if (!node) {
-                    leaf = static_cast<Leaf *>(leaf->links[1]);
-                    if (leaf && leaf->treap) node = leaf->treap->min_node(leaf->treap->root);
-                    else node = nullptr;
-                }
+                skip_forward();
             }
             return *this;
         }
@@ -408,11 +426,7 @@ namespace data_structure {
         const const_iterator operator++(int) {
             if (leaf) {
                 node = YTreap<Int>::succ(node);
-                if (!node) {
-                    leaf = static_cast<Leaf *>(leaf->links[1]);
-                    if (leaf && leaf->treap) node = leaf->treap->min_node(leaf->treap->root);
-                }
-
+                skip_forward();
             }
             return const_iterator(leaf, node);
         }
@@ -420,10 +434,7 @@ namespace data_structure {
         const_iterator &operator--() {
             if (leaf) {
                 node = YTreap<Int>::pred(node);
-                if (!node) {
-                    leaf = static_cast<Leaf *>(leaf->links[0]);
-                    if (leaf && leaf->treap) node = leaf->treap->max_node(leaf->treap->root);
-                }
+                skip_backward();
             }
             return *this;
         }
@@ -431,10 +442,7 @@ namespace data_structure {
         const const_iterator operator--(int) {
             if (leaf) {
                 node = YTreap<Int>::pred(node);
-                if (!node) {
-                    leaf = static_cast<Leaf *>(leaf->links[0]);
-                    if (leaf && leaf->treap) node = leaf->treap->max_node(leaf->treap->root);
-                }
+                skip_backward();
             }
             return const_iterator(leaf, node);
         }
@@ -452,7 +460,7 @@ namespace data_structure {
 
     template<typename Int, size_t bit, template<class, size_t> typename HASH_BUILDER>
     typename YFastTrie<Int, bit, HASH_BUILDER>::const_iterator YFastTrie<Int, bit, HASH_BUILDER>::begin() const {
-        if (!n) end();
+        if (!n) return end();
         return const_iterator(static_cast<Leaf *>(dummy.links[1]));
     }
 
@@ -0,0 +1,314 @@
+#ifndef DATA_STRUCTURE_FOR_LOVE_CONCURRENT_SKIP_QUEUE_HPP
+#define DATA_STRUCTURE_FOR_LOVE_CONCURRENT_SKIP_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <compare.hpp>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <static_random_helper.hpp>
+#include <thread>
+#include <utility>
+
+namespace data_structure {
+    /*
+     * Concurrent min-priority queue on a lock-free skip list, after the SkipQueue of Lotan and Shavit. The list is
+     * the one of SkipList, except that every forward pointer is an atomic word whose low bit marks the node as
+     * removed at that level; insertion links a node bottom up with compare and swap, and any thread passing a marked
+     * node unlinks it.
+     * try_pop claims the first unclaimed node of the bottom level with an atomic exchange, so that exactly one thread
+     * gets it, then marks and unlinks it. Under contention every consumer fights for the same few nodes at the head;
+     * try_pop_relaxed instead lands on a random node among the first O(p log^3 p) ones with a SprayList walk, p being
+     * the concurrency given to the constructor, which spreads the consumers at the price of returning a near minimum.
+     * Both pops are quiescently consistent, not linearizable: a concurrent push of a smaller element may be missed.
+     * Equal elements are ordered by the address of their node, as the list must hold a strict order.
+     * Removed nodes are only retired, they are freed by reclaim() or the destructor, which must not run concurrently
+     * with any other member function; every other member may be called from any number of threads.
+     */
+    template<class T, class Compare = utils::DefaultCompare<T>>
+    class ConcurrentSkipQueue {
+        constexpr static Compare compare{};
+        constexpr static size_t max_height = 32;
+
+        struct Node {
+            T value;
+            size_t height;
+            std::atomic<uintptr_t> *next; // the successor at every level, the low bit marks this node removed
+            std::atomic<bool> claimed{false};
+            Node *retired = nullptr;
+
+            template<typename ...Args>
+            explicit Node(size_t height, Args &&...args)
+                    : value(std::forward<Args>(args)...), height(height), next(new std::atomic<uintptr_t>[height]) {
+                for (size_t i = 0; i < height; ++i) next[i].store(0, std::memory_order_relaxed);
+            }
+
+            ~Node() { delete[](next); }
+        };
+
+        std::atomic<uintptr_t> head[max_height];
+        std::atomic<Node *> retired{nullptr};
+        std::atomic<size_t> count{0};
+        size_t spray_height, spray_jump;
+
+        static Node *pointer(uintptr_t word) noexcept { return reinterpret_cast<Node *>(word & ~uintptr_t(1)); }
+
+        static bool marked(uintptr_t word) noexcept { return word & 1u; }
+
+        static uintptr_t word(Node *node) noexcept { return reinterpret_cast<uintptr_t>(node); }
+
+        static bool before(const Node *a, const Node *b) noexcept;
+
+        static size_t random_height() noexcept;
+
+        static size_t random_below(size_t n) noexcept;
+
+        std::atomic<uintptr_t> &forward(Node *node, size_t level) noexcept {
+            return node ? node->next[level] : head[level];
+        }
+
+        // fills the neighbours of `key` at every level, unlinking the marked nodes on the way; true if key is linked
+        bool find(Node *key, Node **preds, Node **succs);
+
+        void insert(Node *node);
+
+        // try_pop for nodes from `from` on, null standing for the head
+        std::optional<T> claim_from(Node *from);
+
+        void remove(Node *node);
+
+        void unlink_marked() noexcept;
+
+    public:
+        // `concurrency` is the number of threads expected to pop at the same time, it only tunes try_pop_relaxed
+        explicit ConcurrentSkipQueue(size_t concurrency = std::thread::hardware_concurrency());
+
+        ConcurrentSkipQueue(const ConcurrentSkipQueue &) = delete;
+
+        ConcurrentSkipQueue &operator=(const ConcurrentSkipQueue &) = delete;
+
+        ~ConcurrentSkipQueue();
+
+        void push(const T &t);
+
+        template<typename ...Args>
+        void emplace(Args &&...args);
+
+        // removes and returns the minimum, nullopt when the queue looked empty
+        std::optional<T> try_pop();
+
+        // removes and returns one of the smallest elements, nullopt when the queue looked empty
+        std::optional<T> try_pop_relaxed();
+
+        // only approximate while other threads push or pop, as an element is counted just before it can be popped
+        // and uncounted a little after; exact when no operation is in progress
+        size_t size() const noexcept;
+
+        bool empty() const noexcept;
+
+        // frees the retired nodes, must not run concurrently with any other member function
+        void reclaim() noexcept;
+    };
+
+    template<class T, class Compare>
+    bool ConcurrentSkipQueue<T, Compare>::before(const Node *a, const Node *b) noexcept {
+        auto relation = compare(a->value, b->value);
+        return relation == utils::Less || (relation == utils::Eq && std::less<const Node *>()(a, b));
+    }
+
+    template<class T, class Compare>
+    size_t ConcurrentSkipQueue<T, Compare>::random_height() noexcept {
+        thread_local utils::GeoIntGen<size_t> gen;
+        return std::min(gen() + 1, max_height);
+    }
+
+    template<class T, class Compare>
+    size_t ConcurrentSkipQueue<T, Compare>::random_below(size_t n) noexcept {
+        thread_local utils::RandomIntGen<size_t> gen;
+        return gen() % n;
+    }
+
+    template<class T, class Compare>
+    ConcurrentSkipQueue<T, Compare>::ConcurrentSkipQueue(size_t concurrency) {
+        for (auto &i : head) i.store(0, std::memory_order_relaxed);
+        // SprayList parameters: start at level log p + 1 and jump up to log p + 1 nodes at every level
+        size_t log = 0;
+        while ((size_t(2) << log) <= std::max<size_t>(concurrency, 1)) ++log;
+        spray_height = std::min(log + 1, max_height);
+        spray_jump = log + 1;
+    }
+
+    template<class T, class Compare>
+    ConcurrentSkipQueue<T, Compare>::~ConcurrentSkipQueue() {
+        reclaim();
+        auto node = pointer(head[0].load(std::memory_order_relaxed));
+        while (node) {
+            auto next = pointer(node->next[0].load(std::memory_order_relaxed));
+            delete node;
+            node = next;
+        }
+    }
+
+    template<class T, class Compare>
+    bool ConcurrentSkipQueue<T, Compare>::find(Node *key, Node **preds, Node **succs) {
+        retry:
+        Node *pred = nullptr;
+        for (auto level = max_height; level-- > 0;) {
+            auto curr = pointer(forward(pred, level).load(std::memory_order_acquire));
+            while (curr) {
+                auto succ = curr->next[level].load(std::memory_order_acquire);
+                while (marked(succ)) {
+                    auto expected = word(curr);
+                    if (!forward(pred, level).compare_exchange_strong(expected, succ & ~uintptr_t(1),
+                                                                      std::memory_order_acq_rel)) {
+                        goto retry;
+                    }
+                    curr = pointer(succ);
+                    if (!curr) break;
+                    succ = curr->next[level].load(std::memory_order_acquire);
+                }
+                if (!curr || !before(curr, key)) break;
+                pred = curr;
+                curr = pointer(succ);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return succs[0] == key;
+    }
+
+    template<class T, class Compare>
+    void ConcurrentSkipQueue<T, Compare>::insert(Node *node) {
+        Node *preds[max_height], *succs[max_height];
+        // counted before the node is published, so the fetch_sub of the consumer popping it comes after and the
+        // counter never wraps below 0
+        count.fetch_add(1, std::memory_order_relaxed);
+        for (;;) {
+            find(node, preds, succs);
+            for (size_t i = 0; i < node->height; ++i) node->next[i].store(word(succs[i]), std::memory_order_relaxed);
+            auto expected = word(succs[0]);
+            // the release publishes the value together with the node
+            if (forward(preds[0], 0).compare_exchange_strong(expected, word(node), std::memory_order_release))
+                break;
+        }
+        // from now on a consumer may claim the node and mark it; the upper levels are given up as soon as it does
+        for (size_t level = 1; level < node->height; ++level) {
+            for (;;) {
+                auto next = node->next[level].load(std::memory_order_acquire);
+                if (marked(next)) return;
+                if (pointer(next) != succs[level] &&
+                    !node->next[level].compare_exchange_strong(next, word(succs[level]), std::memory_order_acq_rel))
+                    return;
+                auto expected = word(succs[level]);
+                if (forward(preds[level], level).compare_exchange_strong(expected, word(node),
+                                                                         std::memory_order_acq_rel))
+                    break;
+                if (!find(node, preds, succs)) return;
+            }
+        }
+    }
+
+    template<class T, class Compare>
+    void ConcurrentSkipQueue<T, Compare>::remove(Node *node) {
+        Node *preds[max_height], *succs[max_height];
+        for (auto level = node->height; level-- > 0;) {
+            auto next = node->next[level].load(std::memory_order_acquire);
+            while (!marked(next) &&
+                   !node->next[level].compare_exchange_weak(next, next | 1u, std::memory_order_acq_rel));
+        }
+        find(node, preds, succs);
+        count.fetch_sub(1, std::memory_order_relaxed);
+        node->retired = retired.load(std::memory_order_relaxed);
+        while (!retired.compare_exchange_weak(node->retired, node, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    template<class T, class Compare>
+    void ConcurrentSkipQueue<T, Compare>::push(const T &t) {
+        emplace(t);
+    }
+
+    template<class T, class Compare>
+    template<typename... Args>
+    void ConcurrentSkipQueue<T, Compare>::emplace(Args &&... args) {
+        insert(new Node(random_height(), std::forward<Args>(args)...));
+    }
+
+    template<class T, class Compare>
+    std::optional<T> ConcurrentSkipQueue<T, Compare>::claim_from(Node *from) {
+        auto node = from ? from : pointer(head[0].load(std::memory_order_acquire));
+        for (; node; node = pointer(node->next[0].load(std::memory_order_acquire))) {
+            if (node->claimed.load(std::memory_order_relaxed) ||
+                node->claimed.exchange(true, std::memory_order_acquire))
+                continue;
+            // copied, not moved: threads still passing the node compare against its value until reclaim()
+            std::optional<T> res{node->value};
+            remove(node);
+            return res;
+        }
+        return std::nullopt;
+    }
+
+    template<class T, class Compare>
+    std::optional<T> ConcurrentSkipQueue<T, Compare>::try_pop() {
+        return claim_from(nullptr);
+    }
+
+    template<class T, class Compare>
+    std::optional<T> ConcurrentSkipQueue<T, Compare>::try_pop_relaxed() {
+        // the spray: a random walk down from level spray_height, moving forward up to spray_jump nodes per level
+        Node *node = nullptr;
+        for (auto level = spray_height; level-- > 0;) {
+            for (auto jump = random_below(spray_jump + 1); jump; --jump) {
+                auto next = pointer(forward(node, level).load(std::memory_order_acquire));
+                if (!next) break;
+                node = next;
+            }
+        }
+        if (node) {
+            auto res = claim_from(node);
+            if (res) return res;
+        }
+        // landed past every unclaimed node
+        return claim_from(nullptr);
+    }
+
+    template<class T, class Compare>
+    size_t ConcurrentSkipQueue<T, Compare>::size() const noexcept {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    template<class T, class Compare>
+    bool ConcurrentSkipQueue<T, Compare>::empty() const noexcept {
+        return !size();
+    }
+
+    template<class T, class Compare>
+    void ConcurrentSkipQueue<T, Compare>::unlink_marked() noexcept {
+        for (size_t level = 0; level < max_height; ++level) {
+            Node *pred = nullptr;
+            auto curr = pointer(head[level].load(std::memory_order_relaxed));
+            while (curr) {
+                auto next = curr->next[level].load(std::memory_order_relaxed);
+                if (marked(next)) forward(pred, level).store(next & ~uintptr_t(1), std::memory_order_relaxed);
+                else pred = curr;
+                curr = pointer(next);
+            }
+        }
+    }
+
+    template<class T, class Compare>
+    void ConcurrentSkipQueue<T, Compare>::reclaim() noexcept {
+        // an insertion racing with the removal may have linked a node again at an upper level
+        unlink_marked();
+        auto node = retired.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            auto next = node->retired;
+            delete node;
+            node = next;
+        }
+    }
+}
+
+#endif //DATA_STRUCTURE_FOR_LOVE_CONCURRENT_SKIP_QUEUE_HPP
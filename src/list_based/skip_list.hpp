@@ -10,6 +10,7 @@
 #include <cstring>
 #include <iostream>
 #include <compare.hpp>
+#include <optional>
 
 namespace data_structure {
 
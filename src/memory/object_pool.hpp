@@ -84,12 +84,21 @@ namespace data_structure {
 
     template<typename T, size_t ChunkSize, typename PtrContainer>
     void ObjectPool<T, ChunkSize, PtrContainer>::absorb(ObjectPool &that) {
+        if (that.pool.empty()) return;
+        // keep allocating from the chunk with more room left, the rest of the other one goes to the recycle list
+        if (chunk_end - current_address > that.chunk_end - that.current_address) {
+            std::swap(chunk_end, that.chunk_end);
+            std::swap(current_address, that.current_address);
+        }
         while (current_address != chunk_end) {
             recycle_list.push_back(current_address++);
         }
+        // append the shorter lists to the longer ones
+        if (recycle_list.size() < that.recycle_list.size()) std::swap(recycle_list, that.recycle_list);
         for (auto i: that.recycle_list) {
             recycle_list.push_back(i);
         }
+        if (pool.size() < that.pool.size()) std::swap(pool, that.pool);
         for (auto i: that.pool) {
             pool.push_back(i);
         }
@@ -112,11 +121,12 @@ namespace data_structure {
     template<typename T, size_t ChunkSize, typename PtrContainer>
     ObjectPool<T, ChunkSize, PtrContainer> &
     ObjectPool<T, ChunkSize, PtrContainer>::operator=(ObjectPool &&that) noexcept {
-        chunk_end = that.chunk_end;
-        current_address = that.current_address;
-        that.current_address = that.chunk_end = nullptr;
-        pool = std::move(that.pool);
-        recycle_list = std::move(that.recycle_list);
+        // the chunks of this pool are released by that
+        std::swap(chunk_end, that.chunk_end);
+        std::swap(current_address, that.current_address);
+        std::swap(pool, that.pool);
+        std::swap(recycle_list, that.recycle_list);
+        return *this;
     }
 
     template<typename T, size_t ChunkSize, typename PtrContainer>
@@ -10,12 +10,18 @@
 namespace data_structure::utils {
     struct NodeFactory {
         constexpr static bool meldable = false;
+        // all nodes are freed with the factory, so a container of trivially destructible values may skip its teardown
+        constexpr static bool bulk_release = false;
+        // any instance may destroy the nodes of another one, so trees may hand nodes over without melding factories
+        constexpr static bool detachable = false;
     };
 
     template<class Node>
     class TrivialFactory : NodeFactory {
     public:
         constexpr static bool meldable = true;
+        constexpr static bool bulk_release = false;
+        constexpr static bool detachable = true;
 
         template<class ...Args>
         [[nodiscard]] Node *construct(Args &&... args) {
@@ -34,6 +40,8 @@ namespace data_structure::utils {
         ObjectPool<Node, N> pool;
     public:
         constexpr static bool meldable = true;
+        constexpr static bool bulk_release = true;
+        constexpr static bool detachable = false;
 
         template<class ...Args>
         [[nodiscard]] Node *construct(Args &&... args) {
@@ -41,11 +49,12 @@ namespace data_structure::utils {
         }
 
         void destroy(Node *t) {
+            pool.destroy(t);
             pool.recycle(t);
         }
 
         void absorb(PoolFactory &that) {
-            pool.absorb(that);
+            pool.absorb(that.pool);
         }
     };
 
@@ -7,6 +7,7 @@
 
 #include <static_random_helper.hpp>
 #include <random>
+#include <optional>
 
 #ifdef DEBUG
 #include <cassert>